@@ -2,10 +2,13 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
-from esphome.components import online_image, image
+from esphome.components import online_image, image, http_request
 from esphome.const import (
+    CONF_HEIGHT,
     CONF_ID,
+    CONF_WIDTH,
 )
+from esphome.core import ID
 
 # Check if local_image is available in the environment
 try:
@@ -16,20 +19,78 @@ except ImportError:
 
 DEPENDENCIES = ["online_image"]
 AUTO_LOAD = ["online_image"]
+MULTI_CONF = True
 
 CONF_SOURCE = "source"
 CONF_ADVANCE_INTERVAL = "advance_interval"
 CONF_REFRESH_INTERVAL = "refresh_interval"
 CONF_IMAGE_SLOTS = "image_slots"
 CONF_IMAGE_SLOT_COUNT = "image_slot_count"
+CONF_RAW_FRAME_SLOTS = "raw_frame_slots"
+CONF_COUNT = "count"
+CONF_TYPE = "type"
+CONF_HTTP_REQUEST_ID = "http_request_id"
+CONF_COMPRESSED_RESIDENCY = "compressed_residency"
+CONF_LOOP_BUDGET = "loop_budget"
+CONF_ADVANCE_MODE = "advance_mode"
+CONF_READY_GRACE_PERIOD = "ready_grace_period"
+CONF_PREFETCH_AHEAD = "prefetch_ahead"
+CONF_PREFETCH_MEMORY = "prefetch_memory"
+CONF_REVALIDATE = "revalidate"
+CONF_POOL = "pool"
+CONF_MAX_CONCURRENT_LOADS = "max_concurrent_loads"
+CONF_TRACE_SIZE = "trace_size"
+CONF_PATH = "path"
+CONF_MEDIA_DIRECTORY = "media_directory"
+CONF_INDEX_FILE = "index_file"
+CONF_WARM_RESTART = "warm_restart"
+CONF_FRAME_CACHE = "frame_cache"
+CONF_PAGING = "paging"
+CONF_PREVIEW = "preview"
+CONF_FIT = "fit"
+CONF_FRAME_HANDOFF = "frame_handoff"
+CONF_SWAP_TIMEOUT = "swap_timeout"
+CONF_VARIANTS = "variants"
+CONF_INITIAL_THROUGHPUT = "initial_throughput"
+CONF_UPGRADE = "upgrade"
+CONF_MODE = "mode"
+CONF_PAGE_SIZE = "page_size"
+CONF_WATERMARK = "watermark"
+CONF_MAX_RESIDENT_PAGES = "max_resident_pages"
+CONF_ITEMS = "items"
+CONF_NEXT_CURSOR = "next_cursor"
+CONF_ITEM_ID = "item_id"
 CONF_ON_ADVANCE = "on_advance"
 CONF_ON_IMAGE_READY = "on_image_ready"
 CONF_ON_QUEUE_UPDATED = "on_queue_updated"
 CONF_ON_ERROR = "on_error"
 CONF_ON_REFRESH = "on_refresh"
+CONF_ON_PAGE_REQUEST = "on_page_request"
+CONF_ON_FRAME_SWAP = "on_frame_swap"
 
 slideshow_ns = cg.esphome_ns.namespace("slideshow")
 SlideshowComponent = slideshow_ns.class_("SlideshowComponent", cg.Component)
+RawFrameImage = slideshow_ns.class_("RawFrameImage", cg.Component, image.Image)
+
+AdvanceMode = slideshow_ns.enum("AdvanceMode")
+ADVANCE_MODES = {
+    "immediate": AdvanceMode.ADVANCE_MODE_IMMEDIATE,
+    "when_ready": AdvanceMode.ADVANCE_MODE_WHEN_READY,
+}
+
+FitMode = slideshow_ns.enum("FitMode")
+FIT_MODES = {
+    "cover": FitMode.FIT_MODE_COVER,
+    "contain": FitMode.FIT_MODE_CONTAIN,
+    "center_crop": FitMode.FIT_MODE_CENTER_CROP,
+}
+
+ImageType = cg.esphome_ns.namespace("image").enum("ImageType")
+RAW_FRAME_TYPES = {
+    "RGB565": ImageType.IMAGE_TYPE_RGB565,
+    "GRAYSCALE": ImageType.IMAGE_TYPE_GRAYSCALE,
+    "BINARY": ImageType.IMAGE_TYPE_BINARY,
+}
 
 # Triggers
 OnAdvanceTrigger = slideshow_ns.class_("OnAdvanceTrigger", automation.Trigger.template(cg.size_t))
@@ -37,6 +98,10 @@ OnImageReadyTrigger = slideshow_ns.class_("OnImageReadyTrigger", automation.Trig
 OnQueueUpdatedTrigger = slideshow_ns.class_("OnQueueUpdatedTrigger", automation.Trigger.template(cg.size_t))
 OnErrorTrigger = slideshow_ns.class_("OnErrorTrigger", automation.Trigger.template(cg.std_string))
 OnRefreshTrigger = slideshow_ns.class_("OnRefreshTrigger", automation.Trigger.template(cg.size_t))
+OnPageRequestTrigger = slideshow_ns.class_(
+    "OnPageRequestTrigger", automation.Trigger.template(cg.std_string, cg.size_t)
+)
+OnFrameSwapTrigger = slideshow_ns.class_("OnFrameSwapTrigger", automation.Trigger.template(cg.size_t))
 
 # Actions
 AdvanceAction = slideshow_ns.class_("AdvanceAction", automation.Action)
@@ -45,9 +110,14 @@ PauseAction = slideshow_ns.class_("PauseAction", automation.Action)
 ResumeAction = slideshow_ns.class_("ResumeAction", automation.Action)
 RefreshAction = slideshow_ns.class_("RefreshAction", automation.Action)
 EnqueueAction = slideshow_ns.class_("EnqueueAction", automation.Action)
+AppendPageAction = slideshow_ns.class_("AppendPageAction", automation.Action)
+CompleteSwapAction = slideshow_ns.class_("CompleteSwapAction", automation.Action)
+PlayNextAction = slideshow_ns.class_("PlayNextAction", automation.Action)
+RemoveItemAction = slideshow_ns.class_("RemoveItemAction", automation.Action)
 
 SuspendAction = slideshow_ns.class_("SuspendAction", automation.Action)
 UnsuspendAction = slideshow_ns.class_("UnsuspendAction", automation.Action)
+DumpTraceAction = slideshow_ns.class_("DumpTraceAction", automation.Action)
 
 def validate_image_slot(value):
     """Validate that the slot is a supported image type."""
@@ -64,14 +134,101 @@ def validate_image_slot(value):
             cv.use_id(image.Image),
         )(value)
 
-CONFIG_SCHEMA = cv.Schema({
+def slot_type_define(full_id):
+    """Pick the define that compiles in the adapter for this slot's type.
+
+    full_id must be the declaring ID: the use_id reference carries the type of
+    whichever cv.Any branch validated it, which is always the first one.
+    """
+    if HAS_LOCAL_IMAGE and full_id.type.inherits_from(local_image.LocalImage): # pyright: ignore[reportPossiblyUnboundVariable]
+        return "USE_SLIDESHOW_LOCAL_SLOT"
+    if full_id.type.inherits_from(online_image.OnlineImage):
+        return "USE_SLIDESHOW_ONLINE_SLOT"
+    return "USE_SLIDESHOW_EMBEDDED_SLOT"
+
+def validate_pool_settings(config):
+    """A borrowing slideshow loads through the owner's pool, so it has no say in how."""
+    if CONF_RAW_FRAME_SLOTS in config and config.get(CONF_REVALIDATE):
+        # Raw frames are fetched without validators; nothing could be checked
+        raise cv.Invalid("revalidate needs image_slots; raw frames carry no ETag/Last-Modified to check",
+                         path=[CONF_REVALIDATE])
+    if CONF_POOL not in config:
+        return config
+    for key in (CONF_REVALIDATE, CONF_MAX_CONCURRENT_LOADS):
+        if key in config:
+            raise cv.Invalid(f"{key} applies to the shared pool; set it on the slideshow that owns the slots",
+                             path=[key])
+    if CONF_INITIAL_THROUGHPUT in config.get(CONF_VARIANTS, {}):
+        raise cv.Invalid("initial_throughput applies to the shared pool; set it on the slideshow that owns the slots",
+                         path=[CONF_VARIANTS, CONF_INITIAL_THROUGHPUT])
+    return config
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(SlideshowComponent),
 
     cv.Optional(CONF_ADVANCE_INTERVAL): cv.positive_time_period_minutes,
     cv.Optional(CONF_REFRESH_INTERVAL): cv.positive_time_period_minutes,
-
-    cv.Required(CONF_IMAGE_SLOTS): cv.ensure_list(validate_image_slot),
-    cv.Required(CONF_IMAGE_SLOT_COUNT): cv.positive_int,
+    cv.Optional(CONF_ADVANCE_MODE, default="immediate"): cv.enum(ADVANCE_MODES, lower=True),
+    cv.Optional(CONF_READY_GRACE_PERIOD, default="30s"): cv.positive_time_period_milliseconds,
+    # Items after the current one kept loaded; more gives when_ready something to skip to
+    cv.Optional(CONF_PREFETCH_AHEAD, default=1): cv.int_range(min=1, max=32),
+    # Bytes of frames to keep loaded ahead; the lookahead grows past prefetch_ahead while they fit
+    cv.Optional(CONF_PREFETCH_MEMORY): cv.positive_int,
+    cv.Optional(CONF_REVALIDATE): cv.boolean,
+
+    cv.Optional(CONF_IMAGE_SLOTS): cv.ensure_list(validate_image_slot),
+    cv.Optional(CONF_IMAGE_SLOT_COUNT): cv.positive_int,
+    # Slots loading pre-decoded frames (tools/slideshow_frame.py), no decoder involved
+    cv.Optional(CONF_RAW_FRAME_SLOTS): cv.Schema({
+        cv.Required(CONF_COUNT): cv.int_range(min=1),
+        cv.Optional(CONF_TYPE, default="RGB565"): cv.enum(RAW_FRAME_TYPES, upper=True),
+        cv.Optional(CONF_HTTP_REQUEST_ID): cv.use_id(http_request.HttpRequestComponent),
+        # Keep LZ4 frames compressed until displayed, to prefetch more per MB
+        cv.Optional(CONF_COMPRESSED_RESIDENCY, default=False): cv.boolean,
+    }),
+    # Share the slots (and loaded frames) of another slideshow
+    cv.Optional(CONF_POOL): cv.use_id(SlideshowComponent),
+    cv.Optional(CONF_MAX_CONCURRENT_LOADS): cv.positive_int,
+    # Number of events kept in the trace ring buffer (12 bytes each), 0 = off
+    cv.Optional(CONF_TRACE_SIZE, default=0): cv.positive_int,
+    # Time one loop() iteration may spend before deferring work, 0 = unlimited
+    cv.Optional(CONF_LOOP_BUDGET, default="8ms"): cv.positive_time_period_microseconds,
+    # Directory of images for local_image slots, indexed on the card
+    cv.Optional(CONF_MEDIA_DIRECTORY): cv.Schema({
+        cv.Required(CONF_PATH): cv.string,
+        cv.Optional(CONF_INDEX_FILE): cv.string,
+    }),
+    # Persist the queue position (and optionally the last frame) across reboots
+    cv.Optional(CONF_WARM_RESTART): cv.Schema({
+        cv.Optional(CONF_FRAME_CACHE): cv.string,
+    }),
+    # Scale and crop each image to this display's resolution
+    cv.Optional(CONF_FIT): cv.Schema({
+        cv.Required(CONF_WIDTH): cv.int_range(min=1),
+        cv.Required(CONF_HEIGHT): cv.int_range(min=1),
+        cv.Optional(CONF_MODE, default="cover"): cv.enum(FIT_MODES, lower=True),
+    }),
+    # Pick among "url size, url size" variants by measured load throughput
+    cv.Optional(CONF_VARIANTS): cv.Schema({
+        # Bytes per second assumed until a load was timed
+        cv.Optional(CONF_INITIAL_THROUGHPUT): cv.int_range(min=1),
+        cv.Optional(CONF_UPGRADE, default=True): cv.boolean,
+    }),
+    # Hand slot frames to the display double buffered, without copying
+    cv.Optional(CONF_FRAME_HANDOFF): cv.Schema({
+        cv.Optional(CONF_SWAP_TIMEOUT, default="1s"): cv.positive_time_period_milliseconds,
+    }),
+    # Render "source|blurhash" previews at this size while the source loads
+    cv.Optional(CONF_PREVIEW): cv.Schema({
+        cv.Required(CONF_WIDTH): cv.int_range(min=1),
+        cv.Required(CONF_HEIGHT): cv.int_range(min=1),
+    }),
+    # Fetch the playlist a page at a time through on_page_request
+    cv.Optional(CONF_PAGING): cv.Schema({
+        cv.Optional(CONF_PAGE_SIZE, default=50): cv.int_range(min=1),
+        cv.Optional(CONF_WATERMARK, default=10): cv.int_range(min=1),
+        cv.Optional(CONF_MAX_RESIDENT_PAGES, default=4): cv.int_range(min=2),
+    }),
 
     cv.Optional(CONF_ON_ADVANCE): automation.validate_automation({
         cv.GenerateID(automation.CONF_TRIGGER_ID): cv.declare_id(OnAdvanceTrigger),
@@ -88,7 +245,14 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_ON_REFRESH): automation.validate_automation({
         cv.GenerateID(automation.CONF_TRIGGER_ID): cv.declare_id(OnRefreshTrigger),
     }),
-}).extend(cv.COMPONENT_SCHEMA)
+    cv.Optional(CONF_ON_PAGE_REQUEST): automation.validate_automation({
+        cv.GenerateID(automation.CONF_TRIGGER_ID): cv.declare_id(OnPageRequestTrigger),
+    }),
+    cv.Optional(CONF_ON_FRAME_SWAP): automation.validate_automation({
+        cv.GenerateID(automation.CONF_TRIGGER_ID): cv.declare_id(OnFrameSwapTrigger),
+    }),
+}).extend(cv.COMPONENT_SCHEMA), cv.has_exactly_one_key(CONF_IMAGE_SLOTS, CONF_RAW_FRAME_SLOTS, CONF_POOL),
+    validate_pool_settings)
 
 
 async def to_code(config):
@@ -98,13 +262,92 @@ async def to_code(config):
     # Configuration with defaults
     cg.add(var.set_advance_interval(config.get(CONF_ADVANCE_INTERVAL, 5)))
     cg.add(var.set_refresh_interval(config.get(CONF_REFRESH_INTERVAL, 25)))
-    cg.add(var.set_slot_count(config[CONF_IMAGE_SLOT_COUNT]))
-
-    # Add image slots - the overloaded add_image_slot method handles type detection
-    for slot_id in config[CONF_IMAGE_SLOTS]:
-        slot = await cg.get_variable(slot_id)
+    if CONF_IMAGE_SLOTS in config:
+        cg.add(var.set_slot_count(config.get(CONF_IMAGE_SLOT_COUNT, len(config[CONF_IMAGE_SLOTS]))))
+    cg.add(var.set_advance_mode(config[CONF_ADVANCE_MODE]))
+    cg.add(var.set_ready_grace_period(config[CONF_READY_GRACE_PERIOD]))
+    cg.add(var.set_prefetch_ahead(config[CONF_PREFETCH_AHEAD]))
+    if CONF_PREFETCH_MEMORY in config:
+        cg.add(var.set_prefetch_memory(config[CONF_PREFETCH_MEMORY]))
+    cg.add(var.set_revalidate(config.get(CONF_REVALIDATE, False)))
+    cg.add(var.set_max_concurrent_loads(config.get(CONF_MAX_CONCURRENT_LOADS, 0)))
+    cg.add(var.set_trace_size(config[CONF_TRACE_SIZE]))
+    cg.add(var.set_loop_budget(config[CONF_LOOP_BUDGET]))
+
+    if media := config.get(CONF_MEDIA_DIRECTORY):
+        cg.add_define("USE_SLIDESHOW_MEDIA_INDEX")
+        cg.add(var.set_media_directory(media[CONF_PATH].rstrip("/")))
+        if CONF_INDEX_FILE in media:
+            cg.add(var.set_media_index_file(media[CONF_INDEX_FILE]))
+
+    if CONF_WARM_RESTART in config:
+        warm = config[CONF_WARM_RESTART]
+        cg.add_define("USE_SLIDESHOW_WARM_RESTART")
+        cg.add(var.set_restore_key(config[CONF_ID].id))
+        if CONF_FRAME_CACHE in warm:
+            # The restored frame is shown through an embedded image slot
+            cg.add_define("USE_SLIDESHOW_FRAME_CACHE")
+            cg.add_define("USE_SLIDESHOW_EMBEDDED_SLOT")
+            cg.add(var.set_frame_cache_path(warm[CONF_FRAME_CACHE]))
+
+    if fit := config.get(CONF_FIT):
+        # The fitted frame is shown through an embedded image slot
+        cg.add_define("USE_SLIDESHOW_FIT")
+        cg.add_define("USE_SLIDESHOW_EMBEDDED_SLOT")
+        cg.add(var.set_fit(fit[CONF_WIDTH], fit[CONF_HEIGHT], fit[CONF_MODE]))
+
+    if variants := config.get(CONF_VARIANTS):
+        cg.add_define("USE_SLIDESHOW_VARIANTS")
+        if CONF_INITIAL_THROUGHPUT in variants:
+            cg.add(var.set_initial_throughput(variants[CONF_INITIAL_THROUGHPUT]))
+        cg.add(var.set_variant_upgrade(variants[CONF_UPGRADE]))
+
+    if handoff := config.get(CONF_FRAME_HANDOFF):
+        cg.add_define("USE_SLIDESHOW_HANDOFF")
+        cg.add(var.set_swap_timeout(handoff[CONF_SWAP_TIMEOUT]))
+
+    if preview := config.get(CONF_PREVIEW):
+        # The preview frame is shown through an embedded image slot
+        cg.add_define("USE_SLIDESHOW_PREVIEW")
+        cg.add_define("USE_SLIDESHOW_EMBEDDED_SLOT")
+        cg.add(var.set_preview_size(preview[CONF_WIDTH], preview[CONF_HEIGHT]))
+
+    if paging := config.get(CONF_PAGING):
+        cg.add(var.set_page_size(paging[CONF_PAGE_SIZE]))
+        cg.add(var.set_page_watermark(paging[CONF_WATERMARK]))
+        cg.add(var.set_max_resident_pages(paging[CONF_MAX_RESIDENT_PAGES]))
+
+    # Add image slots - the overloaded add_image_slot method handles type detection.
+    # Slots are stored inline, so the pool is sized before any are added.
+    slot_ids = config.get(CONF_IMAGE_SLOTS, [])
+    if slot_ids:
+        cg.add(var.reserve_image_slots(len(slot_ids)))
+    for slot_id in slot_ids:
+        full_id, slot = await cg.get_variable_with_full_id(slot_id)
+        cg.add_define(slot_type_define(full_id))
         cg.add(var.add_image_slot(slot))
 
+    if raw := config.get(CONF_RAW_FRAME_SLOTS):
+        cg.add_define("USE_SLIDESHOW_RAW_SLOT")
+        cg.add(var.set_slot_count(raw[CONF_COUNT]))
+        cg.add(var.reserve_image_slots(raw[CONF_COUNT]))
+        http = None
+        if CONF_HTTP_REQUEST_ID in raw:
+            http = await cg.get_variable(raw[CONF_HTTP_REQUEST_ID])
+        for i in range(raw[CONF_COUNT]):
+            frame_id = ID(f"{config[CONF_ID].id}_raw_frame_{i}", is_declaration=True, type=RawFrameImage)
+            frame = cg.new_Pvariable(frame_id, raw[CONF_TYPE])
+            await cg.register_component(frame, {})
+            if http is not None:
+                cg.add(frame.set_http_request(http))
+            cg.add(frame.set_compressed_residency(raw[CONF_COMPRESSED_RESIDENCY]))
+            cg.add(frame.set_time_budget(config[CONF_LOOP_BUDGET]))
+            cg.add(var.add_image_slot(frame))
+
+    if CONF_POOL in config:
+        pool_owner = await cg.get_variable(config[CONF_POOL])
+        cg.add(var.set_pool_owner(pool_owner))
+
 
     # Setup triggers
     for conf in config.get(CONF_ON_ADVANCE, []):
@@ -129,6 +372,16 @@ async def to_code(config):
         trigger = cg.new_Pvariable(conf[automation.CONF_TRIGGER_ID], var)
         await automation.build_automation(trigger, [(cg.size_t, "current_size")], conf)
 
+    for conf in config.get(CONF_ON_PAGE_REQUEST, []):
+        trigger = cg.new_Pvariable(conf[automation.CONF_TRIGGER_ID], var)
+        await automation.build_automation(
+            trigger, [(cg.std_string, "cursor"), (cg.size_t, "count")], conf
+        )
+
+    for conf in config.get(CONF_ON_FRAME_SWAP, []):
+        trigger = cg.new_Pvariable(conf[automation.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.size_t, "index")], conf)
+
 
 # Actions
 @automation.register_action(
@@ -209,6 +462,66 @@ async def slideshow_enqueue_to_code(config, action_id, template_arg, args):
     cg.add(var.set_items(template_)) # pyright: ignore[reportArgumentType]
     return var
 
+@automation.register_action(
+    "slideshow.append_page",
+    AppendPageAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(SlideshowComponent),
+        cv.Required(CONF_ITEMS): cv.templatable(cv.ensure_list(cv.string)),
+        # Empty marks the last page; the next request starts over
+        cv.Optional(CONF_NEXT_CURSOR, default=""): cv.templatable(cv.string),
+    }),
+)
+async def slideshow_append_page_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    items = await cg.templatable(config[CONF_ITEMS], args, cg.std_vector.template(cg.std_string))
+    cg.add(var.set_items(items))
+    next_cursor = await cg.templatable(config[CONF_NEXT_CURSOR], args, cg.std_string)
+    cg.add(var.set_next_cursor(next_cursor))
+    return var
+
+@automation.register_action(
+    "slideshow.play_next",
+    PlayNextAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(SlideshowComponent),
+        cv.Required(CONF_ITEMS): cv.templatable(cv.ensure_list(cv.string)),
+    }),
+)
+async def slideshow_play_next_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    items = await cg.templatable(config[CONF_ITEMS], args, cg.std_vector.template(cg.std_string))
+    cg.add(var.set_items(items))
+    return var
+
+@automation.register_action(
+    "slideshow.remove_item",
+    RemoveItemAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(SlideshowComponent),
+        cv.Required(CONF_ITEM_ID): cv.templatable(cv.uint32_t),
+    }),
+)
+async def slideshow_remove_item_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    item_id = await cg.templatable(config[CONF_ITEM_ID], args, cg.uint32)
+    cg.add(var.set_item_id(item_id))
+    return var
+
+@automation.register_action(
+    "slideshow.complete_swap",
+    CompleteSwapAction,
+    automation.maybe_simple_id({
+        cv.Required(CONF_ID): cv.use_id(SlideshowComponent),
+    }), # pyright: ignore[reportArgumentType]
+)
+async def slideshow_complete_swap_to_code(config, action_id, template_arg, _args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
+
 @automation.register_action(
     "slideshow.suspend",
     SuspendAction,
@@ -229,4 +542,20 @@ async def slideshow_suspend_to_code(config, action_id, template_arg, _args):
 )
 async def slideshow_unsuspend_to_code(config, action_id, template_arg, _args):
     paren = await cg.get_variable(config[CONF_ID])
-    return cg.new_Pvariable(action_id, template_arg, paren)
\ No newline at end of file
+    return cg.new_Pvariable(action_id, template_arg, paren)
+
+@automation.register_action(
+    "slideshow.dump_trace",
+    DumpTraceAction,
+    automation.maybe_simple_id({
+        cv.Required(CONF_ID): cv.use_id(SlideshowComponent),
+        cv.Optional(CONF_PATH): cv.templatable(cv.string),
+    }), # pyright: ignore[reportArgumentType]
+)
+async def slideshow_dump_trace_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    if CONF_PATH in config:
+        template_ = await cg.templatable(config[CONF_PATH], args, cg.std_string)
+        cg.add(var.set_path(template_))
+    return var
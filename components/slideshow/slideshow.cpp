@@ -1,14 +1,11 @@
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 
-#include "slideshow.h"
+#include <algorithm>
+#include <set>
 
-#include "slideshow_online_image.h"
-#include "slideshow_embedded_image.h"
-#ifdef USE_LOCAL_IMAGE
-#include "esphome/components/local_image/local_image.h"
-#include "slideshow_local_image.h"
-#endif
+#include "slideshow.h"
+#include "slideshow_pool.h"
 
 namespace esphome
 {
@@ -21,27 +18,54 @@ namespace esphome
     {
       ESP_LOGCONFIG(TAG, "Setting up slideshow...");
 
-      if (image_slots_.empty())
+      pool_ = get_pool();
+
+      if (pool_->size() == 0)
       {
         ESP_LOGE(TAG, "No image slots configured!");
         mark_failed();
         return;
       }
 
-      if (slot_count_ == 0)
+      if (pool_owner_ == nullptr && slot_count_ == 0)
       {
         ESP_LOGE(TAG, "Slot count must be greater than zero!");
         mark_failed();
         return;
       }
 
+      pool_->register_owner(this);
+
+      if (trace_size_ > 0)
+      {
+        trace_.reset(new TraceRecorder(trace_size_));
+        if (pool_owner_ == nullptr)
+        {
+          pool_->set_trace(trace_.get());
+        }
+      }
+
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      checkpoint_pref_ = global_preferences->make_preference<SlideshowCheckpoint>(restore_key_, true);
+      if (checkpoint_pref_.load(&checkpoint_))
+      {
+        ESP_LOGI(TAG, "Checkpoint found at index %u, restoring once the queue is populated", checkpoint_.index);
+        restore_pending_ = true;
+      }
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      load_warm_frame_();
+#endif
+
       // Set up scheduled intervals instead of polling
       if (advance_interval_ > 0)
       {
+        last_advance_ = millis();
         set_interval("advance", advance_interval_ * 60000, [this]()
                      {
+          last_advance_ = millis();
           if (!paused_ && !queue_.empty()) {
-            advance();
+            request_advance_();
           } });
       }
 
@@ -50,10 +74,29 @@ namespace esphome
         set_interval("refresh", refresh_interval_ * 60000, [this]()
                      {
           ESP_LOGD(TAG, "Triggering refresh...");
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+          this->start_media_revalidation_();
+#endif
           this->on_refresh_callbacks_.call(0); });
       }
 
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      // The stored index gives a playlist right away; the walk catches up in the background
+      if (media_index_.load())
+      {
+        std::vector<std::string> paths;
+        paths.reserve(media_index_.entries().size());
+        for (const auto &entry : media_index_.entries())
+        {
+          paths.push_back(media_index_.full_path(entry));
+        }
+        enqueue_media_(paths);
+      }
+      start_media_revalidation_();
+#endif
+
       this->on_refresh_callbacks_.call(0);
+      check_page_watermark_();
     }
 
     void SlideshowComponent::dump_config()
@@ -61,43 +104,271 @@ namespace esphome
       ESP_LOGCONFIG(TAG, "Slideshow:");
       ESP_LOGCONFIG(TAG, "  Advance interval: %um", advance_interval_);
       ESP_LOGCONFIG(TAG, "  Refresh interval: %um", refresh_interval_);
-      ESP_LOGCONFIG(TAG, "  Image slots: %d", image_slots_.size());
+      if (advance_mode_ == ADVANCE_MODE_WHEN_READY)
+      {
+        ESP_LOGCONFIG(TAG, "  Advance mode: when ready (grace period: %ums)", ready_grace_period_);
+      }
+      else
+      {
+        ESP_LOGCONFIG(TAG, "  Advance mode: immediate");
+      }
+      ESP_LOGCONFIG(TAG, "  Prefetch ahead: %d", prefetch_ahead_);
+      if (prefetch_memory_ > 0)
+      {
+        ESP_LOGCONFIG(TAG, "  Prefetch memory: %d bytes", prefetch_memory_);
+      }
+      ESP_LOGCONFIG(TAG, "  Image slots: %d%s", pool_->size(), pool_owner_ != nullptr ? " (borrowed)" : "");
+      if (pool_->owner_count() > 1)
+      {
+        ESP_LOGCONFIG(TAG, "  Pool shared by %d slideshows", pool_->owner_count());
+      }
+      ESP_LOGCONFIG(TAG, "  Revalidate held frames: %s", YESNO(pool_->get_revalidate()));
+      if (pool_->get_max_concurrent_loads() > 0)
+      {
+        ESP_LOGCONFIG(TAG, "  Max concurrent loads: %d", pool_->get_max_concurrent_loads());
+      }
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      ESP_LOGCONFIG(TAG, "  Media directory: %s (index: %s)", media_index_.get_directory().c_str(),
+                    media_index_.get_index_file().c_str());
+#endif
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      ESP_LOGCONFIG(TAG, "  Warm restart: YES");
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      ESP_LOGCONFIG(TAG, "  Frame cache: %s", frame_cache_.get_path().c_str());
+#endif
+#ifdef USE_SLIDESHOW_FIT
+      static const char *const FIT_MODE_NAMES[] = {"cover", "contain", "center_crop"};
+      ESP_LOGCONFIG(TAG, "  Fit: %dx%d (%s)", fit_width_, fit_height_, FIT_MODE_NAMES[fit_mode_]);
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      ESP_LOGCONFIG(TAG, "  Previews: %dx%d", preview_width_, preview_height_);
+#endif
+#ifdef USE_SLIDESHOW_HANDOFF
+      ESP_LOGCONFIG(TAG, "  Frame handoff: swap timeout %ums", swap_timeout_);
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      ESP_LOGCONFIG(TAG, "  Variants: initial throughput %u B/s, upgrades %s", pool_->get_throughput()->get_initial(),
+                    variant_upgrade_ ? "on" : "off");
+#endif
+      if (page_size_ > 0)
+      {
+        ESP_LOGCONFIG(TAG, "  Paging: %d items per page, watermark %d, up to %d pages resident", page_size_,
+                      page_watermark_, max_resident_pages_);
+      }
+      ESP_LOGCONFIG(TAG, "  Loop budget: %uus", loop_budget_us_);
     }
 
     void SlideshowComponent::loop()
     {
-      if (suspended_)
-        return;
+      stats_.loop_iterations++;
+
+      if (!suspended_)
+      {
+        TimeBudget budget(loop_budget_us_);
+        run_steps_(budget);
+        record_loop_time_(budget.elapsed_us());
+
+        if (has_pending_work_())
+        {
+          return;
+        }
+      }
+
+      // Nothing left to do; sleep until an advance, enqueue or completion wakes us
+      loop_sleeping_ = true;
+      stats_.loop_sleeps++;
+      disable_loop();
+    }
 
-      // Only reload slots when state has changed (dirty flag optimization)
+    void SlideshowComponent::run_steps_(const TimeBudget &budget)
+    {
+      // Each step is resumable; whatever the budget does not cover runs next iteration.
+      // Only reload slots when state has changed (dirty flag optimization).
+      // Clear first: a synchronous completion may dirty the slots again.
       if (slots_dirty_)
       {
-        ensure_slots_loaded_();
         slots_dirty_ = false;
+        ensure_slots_loaded_();
+      }
+
+      if (loads_scheduled_ && !budget.expired())
+      {
+        loads_scheduled_ = pool_->process_loads(&budget);
       }
 
-      if (needs_more_photos_)
+      if (needs_more_photos_ && !budget.expired())
       {
         refresh();
       }
+
+      if (page_request_due_ && !budget.expired())
+      {
+        request_page_();
+      }
+
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      step_restore_scan_(budget);
+#endif
+
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      if (media_index_.is_revalidating())
+      {
+        step_media_revalidation_(budget);
+      }
+#endif
+
+#ifdef USE_SLIDESHOW_FIT
+      step_fit_(budget);
+#endif
+
+#ifdef USE_SLIDESHOW_PREVIEW
+      step_preview_(budget);
+#endif
+
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      step_frame_cache_(budget);
+#endif
+    }
+
+    void SlideshowComponent::record_loop_time_(uint32_t elapsed_us)
+    {
+      size_t bucket = 0;
+      while (bucket < LOOP_TIME_BUCKETS - 1 && elapsed_us >= LOOP_TIME_BOUNDS_US[bucket])
+      {
+        bucket++;
+      }
+      stats_.loop_time_histogram[bucket]++;
+      stats_.loop_time_max_us = std::max(stats_.loop_time_max_us, elapsed_us);
+      if (loop_budget_us_ != 0 && elapsed_us > loop_budget_us_)
+      {
+        stats_.loops_over_budget++;
+      }
     }
 
-    void SlideshowComponent::add_image_slot(online_image::OnlineImage *slot)
+    void SlideshowComponent::schedule_loads()
     {
-      this->image_slots_.push_back(std::unique_ptr<SlideshowSlot>(new OnlineImageSlot(slot)));
+      loads_scheduled_ = true;
+      wake_();
     }
-    void SlideshowComponent::add_image_slot(esphome::image::Image *slot)
+
+    void SlideshowComponent::suspend(bool suspend)
+    {
+      suspended_ = suspend;
+      if (!suspend && has_pending_work_())
+      {
+        wake_();
+      }
+    }
+
+    void SlideshowComponent::dump_trace()
     {
-      this->image_slots_.push_back(std::unique_ptr<SlideshowSlot>(new EmbeddedImageSlot(slot)));
+      if (!trace_)
+      {
+        ESP_LOGW(TAG, "Tracing is disabled (trace_size: 0)");
+        return;
+      }
+
+      // Base64 lines small enough for the logger; tools/slideshow_trace.py reassembles them
+      static const size_t EVENTS_PER_LINE = 8;
+      ESP_LOGI(TAG, "TRACE BEGIN %u %u", trace_->size(), trace_->dropped());
+      std::vector<uint8_t> chunk;
+      chunk.reserve(EVENTS_PER_LINE * sizeof(TraceEvent));
+      for (size_t i = 0; i < trace_->size(); i++)
+      {
+        const auto *raw = reinterpret_cast<const uint8_t *>(&trace_->at(i));
+        chunk.insert(chunk.end(), raw, raw + sizeof(TraceEvent));
+        if (chunk.size() == chunk.capacity() || i + 1 == trace_->size())
+        {
+          ESP_LOGI(TAG, "TRACE %s", base64_encode(chunk.data(), chunk.size()).c_str());
+          chunk.clear();
+        }
+      }
+      ESP_LOGI(TAG, "TRACE END");
     }
 
-// Guarded implementation for LocalImage
-#ifdef USE_LOCAL_IMAGE
-    void SlideshowComponent::add_image_slot(local_image::LocalImage *slot)
+    bool SlideshowComponent::dump_trace_to_file(const std::string &path)
     {
-      this->image_slots_.push_back(std::unique_ptr<SlideshowSlot>(new LocalImageSlot(slot)));
+      if (!trace_)
+      {
+        ESP_LOGW(TAG, "Tracing is disabled (trace_size: 0)");
+        return false;
+      }
+
+      FILE *file = fopen(path.c_str(), "wb");
+      if (file == nullptr)
+      {
+        ESP_LOGE(TAG, "Cannot open %s for writing", path.c_str());
+        return false;
+      }
+
+      bool ok = trace_->write_to(file);
+      fclose(file);
+      if (ok)
+      {
+        ESP_LOGI(TAG, "Wrote %d trace events to %s", trace_->size(), path.c_str());
+      }
+      else
+      {
+        ESP_LOGE(TAG, "Failed writing trace to %s", path.c_str());
+      }
+      return ok;
     }
+
+    void SlideshowComponent::log_stats()
+    {
+      ESP_LOGI(TAG, "Stats: %u loop iterations, %u wakeups, %u sleeps",
+               stats_.loop_iterations, stats_.loop_wakeups, stats_.loop_sleeps);
+      ESP_LOGI(TAG, "Stats: %u advances, %u images ready, %u errors, %u/%u revalidations hit",
+               stats_.advances, stats_.images_ready, stats_.image_errors,
+               pool_->get_revalidation_hits(), pool_->get_revalidations());
+
+      std::string histogram;
+      char bucket[24];
+      for (size_t i = 0; i < LOOP_TIME_BUCKETS; i++)
+      {
+        if (i + 1 < LOOP_TIME_BUCKETS)
+        {
+          snprintf(bucket, sizeof(bucket), " <%uus:%u", LOOP_TIME_BOUNDS_US[i], stats_.loop_time_histogram[i]);
+        }
+        else
+        {
+          snprintf(bucket, sizeof(bucket), " more:%u", stats_.loop_time_histogram[i]);
+        }
+        histogram += bucket;
+      }
+      ESP_LOGI(TAG, "Stats: loop time max %uus, %u over budget;%s", stats_.loop_time_max_us,
+               stats_.loops_over_budget, histogram.c_str());
+#ifdef USE_SLIDESHOW_VARIANTS
+      for (size_t type = 0; type < ThroughputEstimator::MAX_TYPES; type++)
+      {
+        if (pool_->get_throughput()->is_measured(type))
+        {
+          ESP_LOGI(TAG, "Stats: slot type %d loads at %u B/s", type, pool_->get_throughput()->get(type));
+        }
+      }
 #endif
+    }
+
+    void SlideshowComponent::set_revalidate(bool revalidate)
+    {
+      this->own_pool_.set_revalidate(revalidate);
+    }
+
+    void SlideshowComponent::set_max_concurrent_loads(size_t max)
+    {
+      this->own_pool_.set_max_concurrent_loads(max);
+    }
+
+    SlideshowPool *SlideshowComponent::get_pool()
+    {
+      // Resolve through chains of borrowers to the slideshow that owns the slots
+      if (pool_owner_ != nullptr)
+      {
+        return pool_owner_->get_pool();
+      }
+      return &own_pool_;
+    }
 
     void SlideshowComponent::advance()
     {
@@ -107,23 +378,53 @@ namespace esphome
         return;
       }
 
-      current_index_++;
+      // Manual advances are always immediate and satisfy any pending timed advance
+      cancel_pending_advance_();
+      step_forward_(1);
+    }
+
+    void SlideshowComponent::step_forward_(size_t steps)
+    {
+      // Failed items get another chance once they drop behind the window, so
+      // they load again when they come round; landing on one retries it now
+      if (!failed_ids_.empty())
+      {
+        size_t first_behind = current_index_ % queue_.size() + queue_.size() - 1;
+        for (size_t i = 0; i < std::min(steps, queue_.size()); i++)
+        {
+          forget_failed_((first_behind + i) % queue_.size());
+        }
+        forget_failed_((current_index_ + steps) % queue_.size());
+      }
+      current_index_ += steps;
       size_t current_index_mod = current_index_ % queue_.size();
 
       ESP_LOGD(TAG, "Advanced to index %d/%d (ID: %s)",
                current_index_, queue_.size(), queue_[current_index_mod].source.c_str());
 
-      // Fire callback
-      on_advance_callbacks_.call(current_index_);
+      stats_.advances++;
 
       // Check if we're near the end using modulo index to avoid overflow
-      if (current_index_mod + 2 >= queue_.size())
+      if (page_size_ == 0 && current_index_mod + 2 >= queue_.size())
+      {
+        mark_needs_more_photos_();
+      }
+      finish_navigation_(TRACE_ADVANCE, trace_count(steps));
+    }
+
+    void SlideshowComponent::finish_navigation_(TraceEventType type, uint16_t flags)
+    {
+      // Every change of the current item ends here
+      record_trace_current_(type, flags);
+      checkpoint_position_(true);
+      announce_position_();
+      if (page_size_ > 0)
       {
-        needs_more_photos_ = true;
+        check_page_watermark_();
       }
 
       // Mark slots as needing reload
-      slots_dirty_ = true;
+      mark_slots_dirty_();
     }
 
     void SlideshowComponent::previous()
@@ -134,6 +435,8 @@ namespace esphome
         return;
       }
 
+      cancel_pending_advance_();
+
       // Prevent underflow when current_index_ is 0
       if (current_index_ == 0)
       {
@@ -144,14 +447,11 @@ namespace esphome
         current_index_--;
       }
       size_t current_index_mod = current_index_ % queue_.size();
+      forget_failed_(current_index_mod);
 
       ESP_LOGD(TAG, "Went back to index %d/%d (ID: %s)",
                current_index_, queue_.size(), queue_[current_index_mod].source.c_str());
-
-      on_advance_callbacks_.call(current_index_);
-
-      // Mark slots as needing reload
-      slots_dirty_ = true;
+      finish_navigation_(TRACE_PREVIOUS, 0);
     }
 
     void SlideshowComponent::pause()
@@ -159,6 +459,7 @@ namespace esphome
       if (!paused_)
       {
         paused_ = true;
+        cancel_pending_advance_();
         ESP_LOGI(TAG, "Paused at index %d", current_index_);
       }
     }
@@ -175,8 +476,14 @@ namespace esphome
 
     void SlideshowComponent::refresh()
     {
+      // Sources that failed may be back
+      failed_ids_.clear();
       this->on_refresh_callbacks_.call(0);
       needs_more_photos_ = false;
+
+      // Give a provider that ran dry another chance
+      pages_exhausted_ = false;
+      check_page_watermark_();
     }
 
     void SlideshowComponent::jump_to(size_t index)
@@ -194,22 +501,26 @@ namespace esphome
         return;
       }
 
+      cancel_pending_advance_();
+
       current_index_ = index;
       size_t current_index_mod = current_index_ % queue_.size();
+      forget_failed_(current_index_mod);
 
       ESP_LOGI(TAG, "Jumped to index %d (ID: %s)",
                current_index_, queue_[current_index_mod].source.c_str());
-
-      on_advance_callbacks_.call(current_index_);
-
-      // Mark slots as needing reload
-      slots_dirty_ = true;
+      finish_navigation_(TRACE_JUMP_TO, trace_count(current_index_mod));
     }
 
     void SlideshowComponent::enqueue(const std::vector<std::string> &items)
+    {
+      enqueue_(items, false);
+    }
+
+    size_t SlideshowComponent::enqueue_(const std::vector<std::string> &items, bool new_page)
     {
       if (items.empty())
-        return;
+        return 0;
 
       ESP_LOGI(TAG, "Enqueuing %d new items", items.size());
 
@@ -223,21 +534,34 @@ namespace esphome
           continue;
         }
 
-        QueueItem item;
-        item.source = str; // Store the URL (or "URL|COLOR" string)
-        queue_.push_back(item);
+        queue_.push_back(make_queue_item_(str));
         valid_count++;
       }
 
       if (valid_count > 0)
       {
+        // Paged queues count every item; items outside a page join the newest one
+        if (new_page)
+        {
+          page_lengths_.push_back(valid_count);
+        }
+        else
+        {
+          resize_page_(queue_.size() - valid_count, static_cast<ptrdiff_t>(valid_count));
+        }
+
         ESP_LOGI(TAG, "Successfully enqueued %d valid items", valid_count);
+        record_trace_(TRACE_ENQUEUE, trace_count(valid_count), queue_.size());
+#ifdef USE_SLIDESHOW_WARM_RESTART
+        restore_checkpoint_();
+#endif
         // Notify listeners
         on_queue_updated_callbacks_.call(queue_.size());
 
         // Mark slots as needing reload
-        slots_dirty_ = true;
+        mark_slots_dirty_();
       }
+      return valid_count;
     }
 
     void SlideshowComponent::clear_queue()
@@ -246,293 +570,1771 @@ namespace esphome
 
       queue_.clear();
       current_index_ = 0;
+      failed_ids_.clear();
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      restore_scan_pos_ = 0;
+#endif
+      cancel_pending_advance_();
 
-      // Release all loaded slots
+      // Release all loaded slots, including held frames nobody else uses
       for (const auto &pair : loaded_images_)
       {
         release_slot_(pair.second);
       }
       loaded_images_.clear();
-      loading_slots_.clear();
+      pool_->evict_unused();
+#ifdef USE_SLIDESHOW_FIT
+      fit_resampler_.abort();
+      fit_id_ = 0;
+      fit_ready_ = false;
+      fit_unsupported_ = false;
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      preview_decoder_.abort();
+      preview_ready_ = false;
+      preview_id_ = 0;
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      cancel_upgrade_();
+#endif
+#ifdef USE_SLIDESHOW_HANDOFF
+      cancel_timeout("frame_swap");
+      swap_pending_ = false;
+      clear_frame_(0);
+      clear_frame_(1);
+#endif
 
       needs_more_photos_ = false;
+      record_trace_(TRACE_QUEUE_CLEAR, 0, 0);
+
+      // Paging starts over from the first page
+      page_lengths_.clear();
+      page_cursor_.clear();
+      pages_exhausted_ = false;
 
       // Notify listeners
       on_queue_updated_callbacks_.call(0);
+      check_page_watermark_();
     }
 
-    SlideshowSlot *SlideshowComponent::get_current_image()
+    void SlideshowComponent::append_page(const std::vector<std::string> &items, const std::string &next_cursor)
     {
-      if (queue_.empty())
-        return nullptr;
+      page_request_in_flight_ = false;
+      cancel_timeout("page_request");
 
-      size_t current_index_mod = current_index_ % queue_.size();
-      auto it = loaded_images_.find(current_index_mod);
-      if (it != loaded_images_.end())
-      {
-        size_t slot_idx = it->second;
-        auto *img = image_slots_[slot_idx].get();
+      size_t added = enqueue_(items, true);
 
-        // Only return if image is actually loaded (width > 0)
-        if (img->is_ready())
+      page_cursor_ = next_cursor;
+      if (next_cursor.empty())
+      {
+        if (added == 0)
+        {
+          // Nothing at all came back; asking again would spin
+          ESP_LOGW(TAG, "Provider returned an empty last page, paging stops until refresh");
+          pages_exhausted_ = true;
+        }
+        else
         {
-          return img;
+          ESP_LOGD(TAG, "End of list reached, next page starts over");
         }
       }
-      return nullptr;
+
+      trim_pages_();
+      check_page_watermark_();
     }
 
-    SlideshowSlot *SlideshowComponent::get_slot(size_t slot_index)
+    void SlideshowComponent::insert(size_t position, const std::vector<std::string> &items)
     {
-      if (slot_index < image_slots_.size())
-      {
-        return image_slots_[slot_index].get();
-      }
-      return nullptr;
+      insert_items_(position, items, false);
     }
 
-    void SlideshowComponent::on_image_ready(size_t slot_index)
+    void SlideshowComponent::play_next(const std::vector<std::string> &items)
     {
-      ESP_LOGD(TAG, "Image ready in slot %d", slot_index);
-
-      // Remove from loading set
-      loading_slots_.erase(slot_index);
-
-      // Find which queue index this slot corresponds to
-      for (const auto &pair : loaded_images_)
+      // Behind the play-next items still waiting, in front of everything else
+      size_t position = 0;
+      if (!queue_.empty())
       {
-        if (pair.second == slot_index)
+        position = current_index_ % queue_.size() + 1;
+        while (position < queue_.size() && queue_[position].priority)
         {
-          ESP_LOGI(TAG, "Loaded image %s (queue index %d)",
-                   queue_[pair.first].source.c_str(), pair.first);
-
-          // Fire callback
-          on_image_ready_callbacks_.call(pair.first, false);
-          break;
+          position++;
         }
       }
+      insert_items_(position, items, true);
     }
 
-    void SlideshowComponent::on_image_error(size_t slot_index)
+    void SlideshowComponent::insert_items_(size_t position, const std::vector<std::string> &items, bool priority)
     {
-      ESP_LOGE(TAG, "Error loading image in slot %d", slot_index);
-
-      // Remove from loading set
-      loading_slots_.erase(slot_index);
-
-      // Find which queue index failed
-      for (const auto &pair : loaded_images_)
+      std::vector<QueueItem> added;
+      added.reserve(items.size());
+      for (const auto &str : items)
       {
-        if (pair.second == slot_index)
+        // Validate: skip empty strings or strings that are just whitespace
+        if (str.empty() || str.find_first_not_of(" \t\n\r") == std::string::npos)
         {
-          std::string error = "Failed to load image: " + queue_[pair.first].source;
-          on_error_callbacks_.call(error);
-
-          // Clear the mapping so we can retry
-          loaded_images_.erase(pair.first);
-          break;
+          ESP_LOGW(TAG, "Skipping empty or whitespace-only item");
+          continue;
         }
+        added.push_back(make_queue_item_(str));
+        added.back().priority = priority;
       }
-    }
-
-    // Protected methods
-
-    void SlideshowComponent::update_queue_from_builder_()
-    {
-      if (!queue_builder_)
+      if (added.empty())
       {
-        // If no builder is defined, user might have provided no source.
-        // We can't do anything.
         return;
       }
 
-      // Execute the user's lambda
-      std::vector<std::string> sources = queue_builder_();
+      position = std::min(position, queue_.size());
+      uint32_t current_id = current_item_id();
+      auto slots = take_slots_by_id_();
 
-      if (sources.empty())
-      {
-        ESP_LOGW(TAG, "Source lambda returned empty list");
-        return;
-      }
+      resize_page_(position, static_cast<ptrdiff_t>(added.size()));
+      queue_.insert(queue_.begin() + position, std::make_move_iterator(added.begin()),
+                    std::make_move_iterator(added.end()));
+
+      ESP_LOGI(TAG, "Inserted %d items at index %d%s", added.size(), position, priority ? " (play next)" : "");
+      record_trace_(TRACE_ENQUEUE, trace_count(added.size()), queue_.size());
+      rebase_after_edit_(slots, current_id, 0);
+    }
 
-      std::vector<QueueItem> new_queue;
-      for (const auto &src : sources)
+    bool SlideshowComponent::remove_item(uint32_t item_id)
+    {
+      size_t index = find_item(item_id);
+      if (index == SIZE_MAX)
       {
-        QueueItem item;
-        item.source = src;
-        new_queue.push_back(item);
+        ESP_LOGW(TAG, "Cannot remove item %u: not in the queue", item_id);
+        return false;
       }
 
-      ESP_LOGI(TAG, "Queue updated: %d items", new_queue.size());
+      bool was_current = index == current_index_ % queue_.size();
+      uint32_t current_id = current_item_id();
+      auto slots = take_slots_by_id_();
 
-      queue_ = new_queue;
+      resize_page_(index, -1);
+      queue_.erase(queue_.begin() + index);
 
-      if (current_index_ >= queue_.size())
+      ESP_LOGI(TAG, "Removed item %u (queue index %d)", item_id, index);
+      // The item after a removed current one takes its place
+      rebase_after_edit_(slots, current_id, index);
+
+      if (was_current && !queue_.empty())
       {
-        current_index_ = 0;
+        // Moves on like jump_to, onto the item that took its place
+        cancel_pending_advance_();
+        size_t current_index_mod = current_index_ % queue_.size();
+        forget_failed_(current_index_mod);
+        finish_navigation_(TRACE_JUMP_TO, trace_count(current_index_mod));
       }
-
-      on_queue_updated_callbacks_.call(queue_.size());
-
-      // Mark slots as needing reload
-      slots_dirty_ = true;
+      else if (page_size_ > 0)
+      {
+        check_page_watermark_();
+      }
+      return true;
     }
 
-    void SlideshowComponent::ensure_slots_loaded_()
+    bool SlideshowComponent::splice(const std::vector<uint32_t> &item_ids, size_t position)
     {
-      if (queue_.empty() || image_slots_.empty())
+      // The block lands in front of the first item at or after position that stays put
+      std::set<uint32_t> ids(item_ids.begin(), item_ids.end());
+      uint32_t before_id = 0;
+      for (size_t i = position; i < queue_.size() && before_id == 0; i++)
       {
-        return;
+        if (ids.count(queue_[i].id) == 0)
+        {
+          before_id = queue_[i].id;
+        }
       }
 
-      // Use modulo for current index to avoid out of bounds
-      size_t current_index_mod = current_index_ % queue_.size();
-
-      // Determine which queue indices we want loaded
-      std::set<size_t> desired;
-
-      // Always want current
-      desired.insert(current_index_mod);
-
-      // Previous (wrapped)
-      if (queue_.size() > 1)
+      // One pass lays out the new order as current indices: the items that
+      // stay, with the block at the target
+      std::map<uint32_t, size_t> found;
+      std::vector<size_t> order;
+      order.reserve(queue_.size());
+      size_t target = SIZE_MAX;
+      for (size_t i = 0; i < queue_.size(); i++)
       {
-        size_t prev_index = (current_index_mod + queue_.size() - 1) % queue_.size();
-        desired.insert(prev_index);
+        uint32_t id = queue_[i].id;
+        if (ids.count(id) != 0)
+        {
+          found[id] = i;
+          continue;
+        }
+        if (id == before_id)
+        {
+          target = order.size();
+        }
+        order.push_back(i);
       }
-
-      // Next (wrapped)
-      if (queue_.size() > 1)
+      if (target == SIZE_MAX)
       {
-        size_t next_index = (current_index_mod + 1) % queue_.size();
-        desired.insert(next_index);
+        target = order.size();
       }
 
-      // Release slots outside the desired window
-      auto it = loaded_images_.begin();
-      while (it != loaded_images_.end())
+      std::vector<size_t> block;
+      for (uint32_t id : item_ids)
       {
-        size_t queue_idx = it->first;
-        size_t slot_idx = it->second;
+        auto it = found.find(id);
+        if (it != found.end())
+        {
+          block.push_back(it->second);
+          found.erase(it);
+        }
+      }
+      order.insert(order.begin() + target, block.begin(), block.end());
+
+      bool unchanged = true;
+      for (size_t i = 0; i < order.size() && unchanged; i++)
+      {
+        unchanged = order[i] == i;
+      }
+      if (unchanged)
+      {
+        return false;
+      }
+
+      uint32_t current_id = current_item_id();
+      auto slots = take_slots_by_id_();
+
+      // Pages lose the moved items from the back, so the indices still hold,
+      // then the target's page gains them
+      std::vector<size_t> from = block;
+      std::sort(from.rbegin(), from.rend());
+      for (size_t index : from)
+      {
+        resize_page_(index, -1);
+      }
+      resize_page_(target, static_cast<ptrdiff_t>(block.size()));
+
+      std::vector<QueueItem> queue;
+      queue.reserve(queue_.size());
+      for (size_t index : order)
+      {
+        queue.push_back(std::move(queue_[index]));
+      }
+      queue_ = std::move(queue);
+
+      ESP_LOGI(TAG, "Moved %d items to index %d", block.size(), target);
+      rebase_after_edit_(slots, current_id, 0);
+      return true;
+    }
 
-        if (desired.find(queue_idx) == desired.end())
+    size_t SlideshowComponent::find_item(uint32_t item_id) const
+    {
+      for (size_t i = 0; i < queue_.size(); i++)
+      {
+        if (queue_[i].id == item_id)
         {
-          // This image is no longer needed
-          ESP_LOGD(TAG, "Releasing slot %d (was queue index %d)", slot_idx, queue_idx);
-          release_slot_(slot_idx);
-          it = loaded_images_.erase(it);
+          return i;
+        }
+      }
+      return SIZE_MAX;
+    }
+
+    void SlideshowComponent::resize_page_(size_t queue_index, ptrdiff_t delta)
+    {
+      // Paged queues count items per page; the edit goes to the page holding the index
+      if (page_lengths_.empty())
+      {
+        // Items that arrive before the first page make up one of their own
+        if (page_size_ > 0 && delta > 0)
+        {
+          page_lengths_.push_back(delta);
+        }
+        return;
+      }
+
+      // Pages emptied by an edit stay until trim_pages_(), so a splice that
+      // takes out a whole page can put the items back into it
+      size_t start = 0;
+      for (auto it = page_lengths_.begin(); it != page_lengths_.end(); ++it)
+      {
+        bool into_empty = *it == 0 && delta > 0 && queue_index == start;
+        if (queue_index < start + *it || into_empty || std::next(it) == page_lengths_.end())
+        {
+          if (delta < 0 && static_cast<size_t>(-delta) > *it)
+          {
+            ESP_LOGE(TAG, "Page of %d items cannot lose %d", *it, -delta);
+            *it = 0;
+            return;
+          }
+          *it = delta < 0 ? *it - static_cast<size_t>(-delta) : *it + static_cast<size_t>(delta);
+          return;
+        }
+        start += *it;
+      }
+    }
+
+    std::map<uint32_t, size_t> SlideshowComponent::take_slots_by_id_()
+    {
+      std::map<uint32_t, size_t> slots;
+      for (const auto &pair : loaded_images_)
+      {
+        if (pair.first < queue_.size())
+        {
+          slots[queue_[pair.first].id] = pair.second;
         }
         else
         {
-          ++it;
+          // Left over from a queue rebuild
+          release_slot_(pair.second);
         }
       }
+      loaded_images_.clear();
+      return slots;
+    }
 
-      // Load missing images
-      for (size_t queue_idx : desired)
+    void SlideshowComponent::rebase_after_edit_(const std::map<uint32_t, size_t> &slots, uint32_t current_id,
+                                                size_t fallback_index)
+    {
+      // One pass puts the slots and the position back at the items' new indices
+      std::vector<uint32_t> kept;
+      bool current_found = false;
+      for (size_t i = 0; i < queue_.size() && (kept.size() < slots.size() || !current_found); i++)
       {
-        // Check if already loaded or loading
-        if (loaded_images_.find(queue_idx) != loaded_images_.end())
+        uint32_t id = queue_[i].id;
+        auto it = slots.find(id);
+        if (it != slots.end())
         {
-          continue; // Already loaded
+          loaded_images_[i] = it->second;
+          kept.push_back(id);
+        }
+        if (id == current_id)
+        {
+          current_index_ = i;
+          current_found = true;
         }
+      }
 
-        // Find a free slot
-        size_t slot_idx = find_free_slot_();
-        if (slot_idx == SIZE_MAX)
+      // Items that left the queue give their slots back
+      for (const auto &pair : slots)
+      {
+        if (std::find(kept.begin(), kept.end(), pair.first) == kept.end())
         {
-          ESP_LOGW(TAG, "No free slots available for queue index %d", queue_idx);
-          continue;
+          release_slot_(pair.second);
         }
+      }
+      if (!current_found)
+      {
+        current_index_ = queue_.empty() ? 0 : fallback_index % queue_.size();
+      }
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      restore_scan_pos_ = 0;
+#endif
+
+      checkpoint_position_(false);
+      on_queue_updated_callbacks_.call(queue_.size());
+      mark_slots_dirty_();
+    }
+
+    QueueItem SlideshowComponent::make_queue_item_(const std::string &str)
+    {
+      QueueItem item;
+      item.source = str; // The URL or file path
+      item.id = next_item_id_++;
+#ifdef USE_SLIDESHOW_PREVIEW
+      // "source|blurhash" carries a preview; sources may contain '|' themselves
+      size_t separator = str.find('|');
+      if (separator != std::string::npos && BlurHashDecoder::is_valid(str.substr(separator + 1)))
+      {
+        item.source = str.substr(0, separator);
+        item.preview = str.substr(separator + 1);
+      }
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      // "url 85k, url 310k": the source stays the item's identity, a variant is loaded
+      parse_variants(item.source, item.variants);
+#endif
+      return item;
+    }
+
+    const std::string &SlideshowComponent::load_source_(size_t queue_index) const
+    {
+      const QueueItem &item = queue_[queue_index];
+#ifdef USE_SLIDESHOW_VARIANTS
+      if (!item.variants.empty())
+      {
+        return item.variants[item.variant].source;
+      }
+#endif
+      return item.source;
+    }
+
+    uint32_t SlideshowComponent::load_size_hint_(size_t queue_index) const
+    {
+#ifdef USE_SLIDESHOW_VARIANTS
+      const QueueItem &item = queue_[queue_index];
+      if (!item.variants.empty())
+      {
+        return item.variants[item.variant].size;
+      }
+#endif
+      return 0;
+    }
+
+    uint32_t SlideshowComponent::load_trace_key_(size_t queue_index) const
+    {
+#ifdef USE_SLIDESHOW_VARIANTS
+      // Loads of a variant are traced under the item's source, as navigation is
+      const QueueItem &item = queue_[queue_index];
+      if (trace_ && !item.variants.empty())
+      {
+        return fnv1_hash(item.source);
+      }
+#endif
+      return 0;
+    }
+
+    uint32_t SlideshowComponent::get_item_id(size_t queue_index) const
+    {
+      return queue_index < queue_.size() ? queue_[queue_index].id : 0;
+    }
+
+    uint32_t SlideshowComponent::current_item_id() const
+    {
+      return queue_.empty() ? 0 : queue_[current_index_ % queue_.size()].id;
+    }
+
+    SlideshowSlot *SlideshowComponent::get_current_image()
+    {
+      if (queue_.empty())
+      {
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+        // Right after boot: show the frame restored from the cache
+        if (warm_frame_.is_allocated())
+          return &warm_slot_;
+#endif
+        return nullptr;
+      }
+
+      size_t current_index_mod = current_index_ % queue_.size();
+      auto it = loaded_images_.find(current_index_mod);
+      auto *img = it == loaded_images_.end() ? nullptr : pool_->get_slot(it->second);
+
+      // Only return if image is actually loaded (width > 0)
+      if (img != nullptr && img->is_ready())
+      {
+#ifdef USE_SLIDESHOW_FIT
+        // Until the fitted frame is complete the image is shown unscaled,
+        // so an item that is ready never falls back to a placeholder
+        if (fit_id_ == queue_[current_index_mod].id && fit_ready_)
+          return &fit_slot_;
+#endif
+        return img;
+      }
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      // The cached frame stands in while the same item is downloaded again
+      if (warm_frame_.is_allocated() && fnv1_hash(queue_[current_index_mod].source) == warm_hash_)
+      {
+        return &warm_slot_;
+      }
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      if (preview_ready_ && preview_id_ == queue_[current_index_mod].id)
+      {
+        return &preview_slot_;
+      }
+#endif
+      return nullptr;
+    }
+
+    SlideshowSlot *SlideshowComponent::get_slot(size_t slot_index)
+    {
+      return pool_->get_slot(slot_index);
+    }
 
-        // Load this image
-        load_image_to_slot_(queue_idx, slot_idx);
+    SlideshowSlot *SlideshowComponent::get_slot_for_index(size_t queue_index)
+    {
+      auto it = loaded_images_.find(queue_index);
+      if (it == loaded_images_.end())
+      {
+        return nullptr;
       }
+      return pool_->get_slot(it->second);
     }
 
-    size_t SlideshowComponent::find_free_slot_()
+    void SlideshowComponent::on_image_ready(size_t slot_index)
     {
-      for (size_t i = 0; i < image_slots_.size(); i++)
+      ESP_LOGD(TAG, "Image ready in slot %d", slot_index);
+
+#ifdef USE_SLIDESHOW_VARIANTS
+      if (slot_index == upgrade_slot_)
+      {
+        // Counted once the item has moved over to it
+        finish_upgrade_();
+        return;
+      }
+#endif
+      stats_.images_ready++;
+
+      // Find which queue index this slot corresponds to
+      for (const auto &pair : loaded_images_)
       {
-        size_t mod_i = (i + current_index_) % image_slots_.size();
-        // Check if slot is mapped to a queue index
-        bool in_use = false;
-        for (const auto &pair : loaded_images_)
+        if (pair.second == slot_index)
         {
-          if (pair.second == mod_i)
+          ESP_LOGI(TAG, "Loaded image %s (queue index %d)",
+                   queue_[pair.first].source.c_str(), pair.first);
+
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+          auto *img = pool_->get_slot(slot_index)->get_image();
+          if (img != nullptr)
           {
-            in_use = true;
-            break;
+            media_index_.set_dimensions(queue_[pair.first].source, img->get_width(), img->get_height());
           }
-        }
+#endif
 
-        // Check if slot is currently loading
-        if (loading_slots_.find(mod_i) != loading_slots_.end())
-        {
-          in_use = true;
+          // The current frame (or, with handoff, the staged next one) is
+          // expanded before anyone hears it is ready
+          update_displayed_();
+#ifdef USE_SLIDESHOW_FIT
+          if (pair.first == current_index_ % queue_.size())
+          {
+            // Fit again even if the item was fitted before: the slot has new pixels
+            start_fit_(true);
+          }
+#endif
+
+          // Fire callback
+          on_image_ready_callbacks_.call(pair.first, pool_->get_slot(slot_index)->was_cached());
+          break;
         }
+      }
 
-        if (!in_use)
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      if (!queue_.empty() && is_index_ready_(current_index_ % queue_.size()))
+      {
+        release_warm_frame_();
+        schedule_frame_cache_();
+      }
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      start_upgrade_();
+#endif
+
+      // The memory-sized lookahead takes its next item once this frame's size is known
+      if (prefetch_memory_ > 0)
+      {
+        mark_slots_dirty_();
+      }
+
+      // A timed advance may have been waiting for this image
+      if (advance_pending_)
+      {
+        try_commit_pending_advance_();
+      }
+    }
+
+    void SlideshowComponent::on_image_error(size_t slot_index)
+    {
+      ESP_LOGE(TAG, "Error loading image in slot %d", slot_index);
+      stats_.image_errors++;
+
+#ifdef USE_SLIDESHOW_VARIANTS
+      if (slot_index == upgrade_slot_)
+      {
+        // The variant already shown stays; don't try this item again
+        upgrade_failed_id_ = upgrade_id_;
+        cancel_upgrade_();
+        return;
+      }
+#endif
+
+      // Find which queue indices failed
+      auto it = loaded_images_.begin();
+      while (it != loaded_images_.end())
+      {
+        if (it->second != slot_index)
         {
-          return mod_i;
+          ++it;
+          continue;
         }
+
+        std::string error = "Failed to load image: " + queue_[it->first].source;
+        on_error_callbacks_.call(error);
+
+        // Not loaded again until an advance passes it; the window moves past it
+        failed_ids_.insert(queue_[it->first].id);
+        release_slot_(slot_index);
+        it = loaded_images_.erase(it);
       }
+      mark_slots_dirty_();
 
-      return SIZE_MAX; // No free slot
+      // A timed advance waiting for this item can step over it now
+      if (advance_pending_)
+      {
+        try_commit_pending_advance_();
+      }
     }
 
-    void SlideshowComponent::release_slot_(size_t slot_index)
+    // Protected methods
+
+    void SlideshowComponent::request_advance_()
     {
-      if (slot_index >= image_slots_.size())
+      if (advance_mode_ == ADVANCE_MODE_IMMEDIATE)
+      {
+        advance();
+        return;
+      }
+
+      if (advance_pending_)
       {
+        // Still waiting on the previous tick
         return;
       }
 
-      auto *img = image_slots_[slot_index].get();
-      if (img->is_ready())
+      advance_pending_ = true;
+      grace_expired_ = false;
+
+      if (try_commit_pending_advance_())
       {
-        ESP_LOGD(TAG, "Calling release() on slot %d", slot_index);
-        img->release();
+        return;
       }
 
-      loading_slots_.erase(slot_index);
+      ESP_LOGD(TAG, "Next image not ready, waiting up to %ums", ready_grace_period_);
+      set_timeout("ready_grace", ready_grace_period_, [this]()
+                  {
+        this->grace_expired_ = true;
+        if (!this->try_commit_pending_advance_()) {
+          ESP_LOGW(TAG, "No prefetched image ready after grace period, holding current image");
+        } });
     }
 
-    void SlideshowComponent::load_image_to_slot_(size_t queue_index, size_t slot_index)
+    bool SlideshowComponent::try_commit_pending_advance_()
     {
-      if (queue_index >= queue_.size() || slot_index >= image_slots_.size())
-        return;
+      if (!advance_pending_ || queue_.empty())
+      {
+        return false;
+      }
 
-      auto *slot = image_slots_[slot_index].get();
-      const QueueItem &item = queue_[queue_index];
+      size_t current_index_mod = current_index_ % queue_.size();
+      size_t steps = 0;
+
+      // The next item, not counting ones that failed to load
+      size_t next = next_loadable_step_();
+      if (next != 0 && is_index_ready_((current_index_mod + next) % queue_.size()))
+      {
+        steps = next;
+      }
+      else if (grace_expired_)
+      {
+        // Grace period is over, settle for whatever prefetched item is ready
+        steps = find_nearest_ready_step_();
+      }
+
+      if (steps == 0)
+      {
+        return false;
+      }
 
-      ESP_LOGI(TAG, "Loading source '%s' into slot %d", item.source.c_str(), slot_index);
+      cancel_pending_advance_();
+      if (steps > 1)
+      {
+        ESP_LOGI(TAG, "Skipping %d item(s) that are not ready", steps - 1);
+      }
+      step_forward_(steps);
+      return true;
+    }
 
-      loaded_images_[queue_index] = slot_index;
-      loading_slots_.insert(slot_index);
+    void SlideshowComponent::cancel_pending_advance_()
+    {
+      if (advance_pending_)
+      {
+        cancel_timeout("ready_grace");
+      }
+      advance_pending_ = false;
+      grace_expired_ = false;
+    }
 
-      slot->set_source(item.source);
-      slot->update();
+    size_t SlideshowComponent::find_nearest_ready_step_()
+    {
+      size_t current_index_mod = current_index_ % queue_.size();
+      size_t best = 0;
 
-      // Use weak callback to avoid dangling references
-      slot->callback_once([this, slot_index](bool success)
-                          {
-        // Check if slot is still valid/loading before processing callback
-        if (this->loading_slots_.find(slot_index) == this->loading_slots_.end()) {
-          ESP_LOGD(TAG, "Ignoring callback for released slot %d", slot_index);
-          return;
+      for (const auto &pair : loaded_images_)
+      {
+        size_t distance = (pair.first + queue_.size() - current_index_mod) % queue_.size();
+
+        // Skip the current image, and the previous one unless the queue is tiny
+        if (distance == 0 || (queue_.size() > 2 && distance == queue_.size() - 1))
+        {
+          continue;
         }
 
-        if (success) {
-          this->on_image_ready(slot_index);
-        } else {
-          this->on_image_error(slot_index);
-        } });
+        if ((best == 0 || distance < best) && pool_->get_slot(pair.second)->is_ready())
+        {
+          best = distance;
+        }
+      }
+
+      return best;
+    }
+
+    size_t SlideshowComponent::next_loadable_step_()
+    {
+      size_t current_index_mod = current_index_ % queue_.size();
+      for (size_t step = 1; step < queue_.size(); step++)
+      {
+        if (failed_ids_.count(queue_[(current_index_mod + step) % queue_.size()].id) == 0)
+        {
+          return step;
+        }
+      }
+      // A single item advances onto itself
+      return queue_.size() == 1 ? 1 : 0;
+    }
+
+    void SlideshowComponent::forget_failed_(size_t queue_index)
+    {
+      if (!failed_ids_.empty())
+      {
+        failed_ids_.erase(queue_[queue_index].id);
+      }
+    }
+
+    bool SlideshowComponent::is_index_ready_(size_t queue_index)
+    {
+      auto it = loaded_images_.find(queue_index);
+      if (it == loaded_images_.end())
+      {
+        return false;
+      }
+      return pool_->get_slot(it->second)->is_ready();
+    }
+
+    void SlideshowComponent::check_page_watermark_()
+    {
+      if (page_size_ == 0 || page_request_in_flight_ || pages_exhausted_)
+      {
+        return;
+      }
+
+      size_t remaining = queue_.empty() ? 0 : queue_.size() - 1 - current_index_ % queue_.size();
+      if (remaining < page_watermark_)
+      {
+        page_request_due_ = true;
+        wake_();
+      }
+    }
+
+    void SlideshowComponent::request_page_()
+    {
+      // Retry if the provider never answers
+      static const uint32_t PAGE_REQUEST_TIMEOUT = 30000;
+
+      page_request_due_ = false;
+      page_request_in_flight_ = true;
+      set_timeout("page_request", PAGE_REQUEST_TIMEOUT, [this]()
+                  {
+        ESP_LOGW(TAG, "No answer to page request, asking again");
+        this->page_request_in_flight_ = false;
+        this->check_page_watermark_(); });
+
+      ESP_LOGD(TAG, "Requesting %d items from cursor '%s'", page_size_, page_cursor_.c_str());
+      on_page_request_callbacks_.call(page_cursor_, page_size_);
+    }
+
+    void SlideshowComponent::trim_pages_()
+    {
+      // Pages emptied by edits only go here, never in the middle of one
+      page_lengths_.erase(std::remove(page_lengths_.begin(), page_lengths_.end(), 0), page_lengths_.end());
+
+      if (queue_.empty())
+      {
+        return;
+      }
+
+      // Drop whole pages that have been played, keeping the previous item
+      size_t current_index_mod = current_index_ % queue_.size();
+      size_t count = 0;
+      while (page_lengths_.size() > max_resident_pages_ && count + page_lengths_.front() < current_index_mod)
+      {
+        count += page_lengths_.front();
+        page_lengths_.pop_front();
+      }
+
+      if (count > 0)
+      {
+        drop_front_(count);
+      }
+    }
+
+    void SlideshowComponent::drop_front_(size_t count)
+    {
+      size_t current_index_mod = current_index_ % queue_.size();
+      queue_.erase(queue_.begin(), queue_.begin() + count);
+      current_index_ = current_index_mod - count;
+
+      // Loaded slots follow their items to the new indices
+      std::map<size_t, size_t> shifted;
+      for (const auto &pair : loaded_images_)
+      {
+        if (pair.first < count)
+        {
+          release_slot_(pair.second);
+        }
+        else
+        {
+          shifted[pair.first - count] = pair.second;
+        }
+      }
+      loaded_images_.swap(shifted);
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      restore_scan_pos_ = restore_scan_pos_ > count ? restore_scan_pos_ - count : 0;
+#endif
+
+      ESP_LOGD(TAG, "Dropped %d played items, %d resident", count, queue_.size());
+      checkpoint_position_(false);
+      on_queue_updated_callbacks_.call(queue_.size());
+      mark_slots_dirty_();
+    }
+
+    void SlideshowComponent::ensure_slots_loaded_()
+    {
+      if (queue_.empty() || pool_->size() == 0)
+      {
+        return;
+      }
+
+      // Use modulo for current index to avoid out of bounds
+      size_t current_index_mod = current_index_ % queue_.size();
+      // Once shown, a play-next item has left the lane
+      queue_[current_index_mod].priority = false;
+
+      // Determine which queue indices we want loaded, in load priority order.
+      // Items that failed are left out until an advance passes them.
+      std::vector<size_t> desired;
+      auto want = [&](size_t queue_idx)
+      {
+        if (failed_ids_.count(queue_[queue_idx].id) == 0 &&
+            std::find(desired.begin(), desired.end(), queue_idx) == desired.end())
+        {
+          desired.push_back(queue_idx);
+        }
+      };
+
+      // The next prefetch_ahead_ items (wrapped), stepping over failed ones
+      std::vector<size_t> ahead;
+      for (size_t step = 1; step < queue_.size() && ahead.size() < prefetch_ahead_; step++)
+      {
+        size_t queue_idx = (current_index_mod + step) % queue_.size();
+        if (failed_ids_.count(queue_[queue_idx].id) == 0)
+        {
+          ahead.push_back(queue_idx);
+        }
+      }
+      if (prefetch_memory_ > 0)
+      {
+        extend_lookahead_(current_index_mod, ahead);
+      }
+
+      // Current, next, previous (wrapped), then the rest of the lookahead
+      want(current_index_mod);
+      if (!ahead.empty())
+      {
+        want(ahead[0]);
+      }
+      if (queue_.size() > 2)
+      {
+        want((current_index_mod + queue_.size() - 1) % queue_.size());
+      }
+      for (size_t i = 1; i < ahead.size(); i++)
+      {
+        want(ahead[i]);
+      }
+
+#ifdef USE_SLIDESHOW_VARIANTS
+      // An upgrade is only worth finishing while its item is shown
+      if (upgrade_slot_ != SIZE_MAX && upgrade_id_ != queue_[current_index_mod].id)
+      {
+        cancel_upgrade_();
+      }
+#endif
+
+      // Release slots outside the desired window
+      auto it = loaded_images_.begin();
+      while (it != loaded_images_.end())
+      {
+        size_t queue_idx = it->first;
+        size_t slot_idx = it->second;
+
+        // Drop mappings invalidated by a queue rebuild
+        bool stale = queue_idx >= queue_.size() || pool_->get_source(slot_idx) != load_source_(queue_idx);
+
+        if (stale || std::find(desired.begin(), desired.end(), queue_idx) == desired.end())
+        {
+          // This image is no longer needed
+          ESP_LOGD(TAG, "Releasing slot %d (was queue index %d)", slot_idx, queue_idx);
+          release_slot_(slot_idx);
+          it = loaded_images_.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      // Load missing images
+      for (size_t queue_idx : desired)
+      {
+        // Check if already loaded or loading
+        if (loaded_images_.find(queue_idx) != loaded_images_.end())
+        {
+          continue; // Already loaded
+        }
+
+#ifdef USE_SLIDESHOW_VARIANTS
+        // The current item is needed right away; the others by the next advance
+        choose_variant_(queue_idx, queue_idx == current_index_mod ? 0 : time_until_advance_());
+#endif
+
+        // Take a slot from the pool; shared sources come back already loaded
+        size_t slot_idx = pool_->acquire(this, load_source_(queue_idx), load_size_hint_(queue_idx),
+                                         load_trace_key_(queue_idx));
+        if (slot_idx == SIZE_MAX)
+        {
+          // Lookahead past the next item only takes what the pool has spare
+          if (queue_idx == current_index_mod || (!ahead.empty() && queue_idx == ahead[0]))
+          {
+            ESP_LOGW(TAG, "No free slots available for queue index %d", queue_idx);
+          }
+          continue;
+        }
+
+        loaded_images_[queue_idx] = slot_idx;
+        if (!is_slot_loading_(slot_idx) && pool_->get_slot(slot_idx)->is_ready())
+        {
+          on_image_ready(slot_idx);
+        }
+      }
+
+      // A play-next item loads before anything else queued, except the current one
+      if (!ahead.empty() && queue_[ahead[0]].priority)
+      {
+        auto next = loaded_images_.find(ahead[0]);
+        auto current = loaded_images_.find(current_index_mod);
+        if (next != loaded_images_.end())
+        {
+          pool_->prioritize(this, next->second);
+        }
+        if (current != loaded_images_.end())
+        {
+          pool_->prioritize(this, current->second);
+        }
+      }
+
+      schedule_loads();
+      update_displayed_();
+#ifdef USE_SLIDESHOW_FIT
+      start_fit_(false);
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      start_preview_();
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      start_upgrade_();
+#endif
+    }
+
+    void SlideshowComponent::extend_lookahead_(size_t current_index_mod, std::vector<size_t> &ahead)
+    {
+      auto held_bytes = [this](size_t queue_idx) -> size_t
+      {
+        auto it = loaded_images_.find(queue_idx);
+        return it == loaded_images_.end() ? 0 : pool_->get_resident_bytes(it->second);
+      };
+
+      size_t held = held_bytes(current_index_mod);
+      if (queue_.size() > 2)
+      {
+        held += held_bytes((current_index_mod + queue_.size() - 1) % queue_.size());
+      }
+      for (size_t queue_idx : ahead)
+      {
+        held += held_bytes(queue_idx);
+      }
+
+      // Each further item is admitted if a frame the size of the one before it
+      // still fits, so a frame is never dropped again for its own size. One
+      // item loads at a time, since its size is only known once it has.
+      size_t estimate = ahead.empty() ? 0 : held_bytes(ahead.back());
+      size_t first_step = 1;
+      if (!ahead.empty())
+      {
+        first_step = (ahead.back() + queue_.size() - current_index_mod) % queue_.size() + 1;
+      }
+      for (size_t step = first_step; step + 1 < queue_.size(); step++)
+      {
+        size_t queue_idx = (current_index_mod + step) % queue_.size();
+        if (failed_ids_.count(queue_[queue_idx].id) != 0)
+        {
+          continue;
+        }
+        if (held + estimate > prefetch_memory_)
+        {
+          break;
+        }
+
+        ahead.push_back(queue_idx);
+        auto it = loaded_images_.find(queue_idx);
+        if (it == loaded_images_.end() || !pool_->get_slot(it->second)->is_ready())
+        {
+          break;
+        }
+        estimate = pool_->get_resident_bytes(it->second);
+        held += estimate;
+      }
+    }
+
+    void SlideshowComponent::update_displayed_()
+    {
+      // The only place that tells the pool which slot is on screen. Compactly
+      // held frames are expanded here, before anything draws or fits them.
+#ifdef USE_SLIDESHOW_HANDOFF
+      // The frame swap decides: the front frame is shown, and pinned
+      update_handoff_();
+#else
+      if (queue_.empty())
+      {
+        return;
+      }
+      auto it = loaded_images_.find(current_index_ % queue_.size());
+      bool ready = it != loaded_images_.end() && pool_->get_slot(it->second)->is_ready();
+      pool_->set_displayed(this, ready ? it->second : SIZE_MAX);
+#endif
+    }
+
+    void SlideshowComponent::announce_position_()
+    {
+      // Listeners redraw right away, so the frame is ready for them first
+      update_displayed_();
+      on_advance_callbacks_.call(current_index_);
+    }
+
+    void SlideshowComponent::release_slot_(size_t slot_index)
+    {
+      pool_->release(this, slot_index);
+    }
+
+    void SlideshowComponent::record_trace_(TraceEventType type, uint16_t flags, uint32_t arg)
+    {
+      if (trace_)
+      {
+        trace_->record(millis(), type, TRACE_NO_SLOT, flags, arg);
+      }
+    }
+
+    void SlideshowComponent::record_trace_current_(TraceEventType type, uint16_t flags)
+    {
+      if (trace_ && !queue_.empty())
+      {
+        record_trace_(type, flags, fnv1_hash(queue_[current_index_ % queue_.size()].source));
+      }
+    }
+
+    void SlideshowComponent::checkpoint_position_(bool navigated)
+    {
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      // Navigating gives up on a checkpoint that never showed up in the queue
+      if (navigated)
+      {
+        restore_pending_ = false;
+      }
+      save_checkpoint_();
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      if (navigated && warm_frame_.is_allocated() && fnv1_hash(queue_[current_index_ % queue_.size()].source) != warm_hash_)
+      {
+        release_warm_frame_();
+      }
+      schedule_frame_cache_();
+#endif
+    }
+
+#ifdef USE_SLIDESHOW_WARM_RESTART
+    void SlideshowComponent::save_checkpoint_()
+    {
+      // Keep the stored position until the queue it refers to has been seen
+      if (restore_pending_ || queue_.empty())
+      {
+        return;
+      }
+
+      size_t current_index_mod = current_index_ % queue_.size();
+      SlideshowCheckpoint checkpoint{static_cast<uint32_t>(current_index_mod),
+                                     fnv1_hash(queue_[current_index_mod].source)};
+      if (checkpoint.index == checkpoint_.index && checkpoint.source_hash == checkpoint_.source_hash)
+      {
+        return;
+      }
+
+      // Preferences reach flash on the flash_write_interval, which bounds wear
+      checkpoint_ = checkpoint;
+      checkpoint_pref_.save(&checkpoint_);
+    }
+
+    void SlideshowComponent::restore_checkpoint_()
+    {
+      if (!restore_pending_ || queue_.empty())
+      {
+        return;
+      }
+
+      // Same queue as before the reboot: the index still points at the item
+      if (checkpoint_.index < queue_.size() && fnv1_hash(queue_[checkpoint_.index].source) == checkpoint_.source_hash)
+      {
+        apply_restore_(checkpoint_.index);
+        return;
+      }
+
+      // Otherwise search the queue from the loop, a slice at a time
+      if (restore_scan_pos_ < queue_.size())
+      {
+        wake_();
+      }
+    }
+
+    void SlideshowComponent::step_restore_scan_(const TimeBudget &budget)
+    {
+      // Hash a batch of items between budget checks
+      static const size_t ITEMS_PER_CHECK = 32;
+      while (restore_pending_ && restore_scan_pos_ < queue_.size() && !budget.expired())
+      {
+        size_t end = std::min(restore_scan_pos_ + ITEMS_PER_CHECK, queue_.size());
+        for (; restore_scan_pos_ < end; restore_scan_pos_++)
+        {
+          if (fnv1_hash(queue_[restore_scan_pos_].source) == checkpoint_.source_hash)
+          {
+            apply_restore_(restore_scan_pos_);
+            return;
+          }
+        }
+      }
+      // Not found: the item may still arrive with a later enqueue
+    }
+
+    void SlideshowComponent::apply_restore_(size_t index)
+    {
+      restore_pending_ = false;
+      cancel_pending_advance_();
+      current_index_ = index;
+      ESP_LOGI(TAG, "Restored position %d (ID: %s)", current_index_, queue_[current_index_].source.c_str());
+
+      announce_position_();
+      mark_slots_dirty_();
+    }
+#endif
+
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+    void SlideshowComponent::load_warm_frame_()
+    {
+      warm_hash_ = frame_cache_.read(warm_frame_);
+      if (warm_hash_ == 0)
+      {
+        return;
+      }
+
+      warm_slot_.bind<EmbeddedImageSlot>(warm_frame_.get_image());
+
+      // Let the display draw the restored frame before the network is up
+      on_advance_callbacks_.call(current_index_);
+    }
+
+    void SlideshowComponent::release_warm_frame_()
+    {
+      if (!warm_frame_.is_allocated())
+      {
+        return;
+      }
+
+      // warm_slot_ keeps a dangling image pointer; it is only handed out while the frame is allocated
+      ESP_LOGD(TAG, "Releasing restored frame");
+      warm_frame_.free();
+      warm_hash_ = 0;
+    }
+
+    void SlideshowComponent::schedule_frame_cache_()
+    {
+      // Write once an image has stayed on screen for a while, so skipping
+      // through the queue does not rewrite the card for every frame
+      static const uint32_t FRAME_CACHE_DELAY = 5000;
+      set_timeout("frame_cache", FRAME_CACHE_DELAY, [this]()
+                  {
+        this->frame_cache_due_ = true;
+        this->wake_(); });
+    }
+
+    void SlideshowComponent::step_frame_cache_(const TimeBudget &budget)
+    {
+      // Bytes per write call; the card is written over several iterations
+      static const size_t FRAME_CACHE_CHUNK = 8192;
+      if (budget.expired() || (!frame_cache_due_ && !frame_cache_.is_writing()))
+      {
+        return;
+      }
+
+      SlideshowSlot *slot = nullptr;
+      uint32_t source_hash = 0;
+      if (!queue_.empty())
+      {
+        size_t current_index_mod = current_index_ % queue_.size();
+        slot = get_slot_for_index(current_index_mod);
+        source_hash = fnv1_hash(queue_[current_index_mod].source);
+      }
+      if (slot != nullptr && !slot->is_ready())
+      {
+        slot = nullptr;
+      }
+
+      if (frame_cache_due_)
+      {
+        frame_cache_due_ = false;
+        if (slot != nullptr && source_hash != frame_cache_.get_cached_hash())
+        {
+          frame_cache_.begin_write(slot->get_image(), source_hash);
+        }
+      }
+
+      if (!frame_cache_.is_writing())
+      {
+        return;
+      }
+
+      // The frame being written must still be loaded, or the file would be torn
+      if (slot == nullptr || slot->get_image()->get_data_start() != frame_cache_.get_write_data())
+      {
+        ESP_LOGD(TAG, "Current frame changed, abandoning frame cache write");
+        frame_cache_.abort_write();
+        return;
+      }
+
+      while (!budget.expired())
+      {
+        if (frame_cache_.write_step(FRAME_CACHE_CHUNK))
+          break;
+      }
+    }
+#endif
+
+#ifdef USE_SLIDESHOW_FIT
+    void SlideshowComponent::start_fit_(bool force)
+    {
+      size_t current_index_mod = current_index_ % queue_.size();
+      uint32_t id = queue_[current_index_mod].id;
+      if (!force && id == fit_id_ && (fit_ready_ || fit_unsupported_ || fit_resampler_.is_resampling()))
+      {
+        return;
+      }
+
+      auto it = loaded_images_.find(current_index_mod);
+      if (it == loaded_images_.end() || !pool_->get_slot(it->second)->is_ready())
+      {
+        // Nothing to fit yet; stop working on an item that is no longer shown
+        fit_resampler_.abort();
+        return;
+      }
+
+      // update_displayed_() expands the current frame; one held compactly is
+      // fitted once it has been
+      auto *img = pool_->get_slot(it->second)->get_image();
+      if (img == nullptr || img->get_data_start() == nullptr)
+      {
+        return;
+      }
+
+      fit_id_ = id;
+      fit_ready_ = false;
+      fit_unsupported_ = false;
+      fit_render_us_ = 0;
+
+      if (!FrameResampler::supports(img))
+      {
+        ESP_LOGD(TAG, "Cannot fit this image type, showing it unscaled");
+        fit_unsupported_ = true;
+        return;
+      }
+
+      // One display-sized buffer, reused for every image
+      if (!fit_frame_.is_allocated())
+      {
+        if (!fit_frame_.allocate(fit_width_, fit_height_, esphome::image::IMAGE_TYPE_RGB565))
+        {
+          ESP_LOGW(TAG, "Cannot allocate %dx%d fit frame, showing images unscaled", fit_width_, fit_height_);
+          fit_unsupported_ = true;
+          return;
+        }
+        fit_slot_.bind<EmbeddedImageSlot>(fit_frame_.get_image());
+      }
+
+      if (fit_resampler_.begin(img, &fit_frame_, fit_mode_))
+      {
+        wake_();
+      }
+      else
+      {
+        fit_unsupported_ = true;
+      }
+    }
+
+    void SlideshowComponent::step_fit_(const TimeBudget &budget)
+    {
+      // Output rows per resample call between budget checks
+      static const int FIT_ROWS_PER_STEP = 8;
+      if (!fit_resampler_.is_resampling() || budget.expired())
+      {
+        return;
+      }
+
+      // The source must stay loaded, or the frame would mix two images
+      SlideshowSlot *slot = queue_.empty() ? nullptr : get_slot_for_index(current_index_ % queue_.size());
+      if (slot == nullptr || !slot->is_ready() || slot->get_image()->get_data_start() != fit_resampler_.get_source_data())
+      {
+        ESP_LOGD(TAG, "Source changed, abandoning fit");
+        fit_resampler_.abort();
+        fit_id_ = 0;
+        return;
+      }
+
+      uint32_t start = micros();
+      bool done;
+      do
+      {
+        done = fit_resampler_.resample_rows(FIT_ROWS_PER_STEP);
+      } while (!done && !budget.expired());
+      fit_render_us_ += micros() - start;
+
+      if (done)
+      {
+        fit_ready_ = true;
+        ESP_LOGD(TAG, "Fitted %dx%d image in %uus", slot->get_image()->get_width(), slot->get_image()->get_height(),
+                 fit_render_us_);
+      }
+    }
+#endif
+
+#ifdef USE_SLIDESHOW_PREVIEW
+    void SlideshowComponent::start_preview_()
+    {
+      size_t current_index_mod = current_index_ % queue_.size();
+      const QueueItem &item = queue_[current_index_mod];
+      if (item.preview.empty() || item.id == preview_id_ || is_index_ready_(current_index_mod))
+      {
+        return;
+      }
+
+      // One panel-sized buffer, kept for every later preview
+      if (!preview_frame_.is_allocated())
+      {
+        if (!preview_frame_.allocate(preview_width_, preview_height_, esphome::image::IMAGE_TYPE_RGB565))
+        {
+          ESP_LOGW(TAG, "Cannot allocate %dx%d preview frame", preview_width_, preview_height_);
+          return;
+        }
+        preview_slot_.bind<EmbeddedImageSlot>(preview_frame_.get_image());
+      }
+
+      preview_ready_ = false;
+      preview_id_ = item.id;
+      preview_render_us_ = 0;
+      if (preview_decoder_.begin(item.preview, &preview_frame_))
+      {
+        wake_();
+      }
+    }
+
+    void SlideshowComponent::step_preview_(const TimeBudget &budget)
+    {
+      // Rows per decode call between budget checks
+      static const int PREVIEW_ROWS_PER_STEP = 16;
+      if (!preview_decoder_.is_decoding() || budget.expired())
+      {
+        return;
+      }
+
+      uint32_t start = micros();
+      bool done;
+      do
+      {
+        done = preview_decoder_.decode_rows(PREVIEW_ROWS_PER_STEP);
+      } while (!done && !budget.expired());
+      preview_render_us_ += micros() - start;
+
+      if (done)
+      {
+        preview_ready_ = true;
+        ESP_LOGD(TAG, "Rendered preview in %uus", preview_render_us_);
+      }
+    }
+#endif
+
+    void SlideshowComponent::complete_swap()
+    {
+#ifdef USE_SLIDESHOW_HANDOFF
+      if (!swap_pending_)
+      {
+        return;
+      }
+      cancel_timeout("frame_swap");
+      swap_pending_ = false;
+
+      // The display let go of the old frame: unpin it and stage the next one.
+      // Loads that found no free slot while it was pinned get another go.
+      clear_frame_(front_frame_ ^ 1);
+      update_handoff_();
+      mark_slots_dirty_();
+#endif
+    }
+
+#ifdef USE_SLIDESHOW_HANDOFF
+    void SlideshowComponent::update_handoff_()
+    {
+      // The back frame is still on screen until the last swap completes
+      if (queue_.empty() || swap_pending_)
+      {
+        return;
+      }
+
+      size_t current_index_mod = current_index_ % queue_.size();
+
+      if (!frame_matches_(front_frame_, current_index_mod))
+      {
+        // Usually the current item was staged ahead; otherwise stage it now,
+        // or keep showing the old frame until it is ready
+        if (!frame_matches_(front_frame_ ^ 1, current_index_mod) && !stage_frame_(current_index_mod))
+        {
+          return;
+        }
+
+        front_frame_ ^= 1;
+        pool_->set_displayed(this, frame_slots_[front_frame_]);
+        swap_pending_ = frame_slots_[front_frame_ ^ 1] != SIZE_MAX;
+        ESP_LOGD(TAG, "Swapped to the frame of queue index %d", current_index_mod);
+        on_frame_swap_callbacks_.call(current_index_);
+
+        if (swap_pending_)
+        {
+          set_timeout("frame_swap", swap_timeout_, [this]()
+                      {
+                        ESP_LOGW(TAG, "Display did not complete the frame swap, releasing the old frame");
+                        complete_swap(); });
+          return;
+        }
+      }
+
+      // Stage the next item so the next advance swaps without waiting
+      if (queue_.size() > 1)
+      {
+        size_t next_index = (current_index_mod + 1) % queue_.size();
+        if (!frame_matches_(front_frame_ ^ 1, next_index))
+        {
+          stage_frame_(next_index);
+        }
+      }
+    }
+
+    bool SlideshowComponent::frame_matches_(uint8_t frame, size_t queue_index) const
+    {
+      if (frames_[frame].item_id != queue_[queue_index].id)
+      {
+        return false;
+      }
+      // Same item, but its frame may have moved to another slot (e.g. a better variant)
+      auto it = loaded_images_.find(queue_index);
+      return it == loaded_images_.end() || it->second == frame_slots_[frame];
+    }
+
+    bool SlideshowComponent::stage_frame_(size_t queue_index)
+    {
+      auto it = loaded_images_.find(queue_index);
+      if (it == loaded_images_.end() || is_slot_loading_(it->second) || !pool_->get_slot(it->second)->is_ready())
+      {
+        return false;
+      }
+
+      uint8_t back = front_frame_ ^ 1;
+      clear_frame_(back);
+
+      // Pinning expands compactly held frames, so the image is read afterwards
+      size_t slot_idx = it->second;
+      pool_->pin(slot_idx);
+      auto *img = pool_->get_slot(slot_idx)->get_image();
+      if (img == nullptr || img->get_data_start() == nullptr)
+      {
+        pool_->unpin(slot_idx);
+        return false;
+      }
+
+      FrameDescriptor &frame = frames_[back];
+      frame.data = img->get_data_start();
+      frame.size = image_frame_bytes(img);
+      frame.width = img->get_width();
+      frame.height = img->get_height();
+      frame.type = img->get_type();
+      frame.item_id = queue_[queue_index].id;
+      frame.image = img;
+#ifdef USE_LVGL
+      frame.lv_img_dsc = img->get_lv_img_dsc();
+#endif
+      frame_slots_[back] = slot_idx;
+      return true;
+    }
+
+    void SlideshowComponent::clear_frame_(uint8_t frame)
+    {
+      if (frame_slots_[frame] != SIZE_MAX)
+      {
+        pool_->unpin(frame_slots_[frame]);
+        frame_slots_[frame] = SIZE_MAX;
+      }
+      frames_[frame] = FrameDescriptor{};
+    }
+#endif
+
+#ifdef USE_SLIDESHOW_VARIANTS
+    uint32_t SlideshowComponent::time_until_advance_() const
+    {
+      if (paused_ || advance_interval_ == 0)
+      {
+        return UINT32_MAX;
+      }
+      uint32_t interval = advance_interval_ * 60000;
+      uint32_t elapsed = millis() - last_advance_;
+      return elapsed < interval ? interval - elapsed : 0;
+    }
+
+    void SlideshowComponent::choose_variant_(size_t queue_index, uint32_t available_ms)
+    {
+      QueueItem &item = queue_[queue_index];
+      if (item.variants.empty())
+      {
+        return;
+      }
+      // A quarter of the time is kept as headroom for a slower than estimated load
+      uint32_t throughput = pool_->estimate_throughput();
+      item.variant = choose_variant(item.variants, throughput, available_ms / 4 * 3);
+      ESP_LOGD(TAG, "Queue index %d: variant %d of %d (%u bytes) at %u B/s, %ums left", queue_index,
+               item.variant + 1, item.variants.size(), item.variants[item.variant].size, throughput, available_ms);
+    }
+
+    void SlideshowComponent::start_upgrade_()
+    {
+      if (!variant_upgrade_ || upgrade_slot_ != SIZE_MAX || queue_.empty())
+      {
+        return;
+      }
+
+      // Loads for the window (the shown item, then the next one) come first
+      auto loaded = [this](size_t queue_index)
+      {
+        auto it = loaded_images_.find(queue_index);
+        return it != loaded_images_.end() && !is_slot_loading_(it->second) && pool_->get_slot(it->second)->is_ready();
+      };
+      size_t current_index_mod = current_index_ % queue_.size();
+      QueueItem &item = queue_[current_index_mod];
+      if (item.variants.empty() || item.id == upgrade_failed_id_ || !loaded(current_index_mod))
+      {
+        return;
+      }
+      if (queue_.size() > 1 && !loaded((current_index_mod + 1) % queue_.size()))
+      {
+        return;
+      }
+
+      size_t best = choose_variant(item.variants, pool_->estimate_throughput(), time_until_advance_() / 4 * 3);
+      if (best <= item.variant)
+      {
+        return;
+      }
+
+      // Loaded into a spare slot; the shown variant stays until it is ready
+      size_t slot_idx = pool_->acquire(this, item.variants[best].source, item.variants[best].size,
+                                       load_trace_key_(current_index_mod));
+      if (slot_idx == SIZE_MAX)
+      {
+        return;
+      }
+      ESP_LOGD(TAG, "Upgrading queue index %d to variant %d (%u bytes)", current_index_mod, best + 1,
+               item.variants[best].size);
+      upgrade_id_ = item.id;
+      upgrade_slot_ = slot_idx;
+      upgrade_variant_ = best;
+
+      if (!is_slot_loading_(slot_idx) && pool_->get_slot(slot_idx)->is_ready())
+      {
+        finish_upgrade_();
+      }
+    }
+
+    void SlideshowComponent::finish_upgrade_()
+    {
+      size_t slot_idx = upgrade_slot_;
+      upgrade_slot_ = SIZE_MAX;
+
+      if (queue_.empty() || current_item_id() != upgrade_id_)
+      {
+        release_slot_(slot_idx);
+        return;
+      }
+      size_t current_index_mod = current_index_ % queue_.size();
+
+      // Swap the item over to the new slot, then handle it like any fresh image
+      auto it = loaded_images_.find(current_index_mod);
+      if (it != loaded_images_.end())
+      {
+        release_slot_(it->second);
+      }
+      loaded_images_[current_index_mod] = slot_idx;
+      queue_[current_index_mod].variant = upgrade_variant_;
+      ESP_LOGI(TAG, "Upgraded queue index %d to variant %d", current_index_mod, upgrade_variant_ + 1);
+      on_image_ready(slot_idx);
+    }
+
+    void SlideshowComponent::cancel_upgrade_()
+    {
+      if (upgrade_slot_ != SIZE_MAX)
+      {
+        release_slot_(upgrade_slot_);
+        upgrade_slot_ = SIZE_MAX;
+      }
+    }
+#endif
+
+    void SlideshowComponent::mark_slots_dirty_()
+    {
+      slots_dirty_ = true;
+      wake_();
+    }
+
+    void SlideshowComponent::mark_needs_more_photos_()
+    {
+      needs_more_photos_ = true;
+      wake_();
+    }
+
+    bool SlideshowComponent::has_pending_work_()
+    {
+      if (slots_dirty_ || needs_more_photos_ || loads_scheduled_ || page_request_due_)
+      {
+        return true;
+      }
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      if (restore_pending_ && restore_scan_pos_ < queue_.size())
+      {
+        return true;
+      }
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      if (frame_cache_due_ || frame_cache_.is_writing())
+      {
+        return true;
+      }
+#endif
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      if (media_index_.is_revalidating())
+      {
+        return true;
+      }
+#endif
+#ifdef USE_SLIDESHOW_FIT
+      if (fit_resampler_.is_resampling())
+      {
+        return true;
+      }
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      if (preview_decoder_.is_decoding())
+      {
+        return true;
+      }
+#endif
+      return false;
+    }
+
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+    void SlideshowComponent::start_media_revalidation_()
+    {
+      if (media_index_.begin_revalidate())
+      {
+        wake_();
+      }
+    }
+
+    void SlideshowComponent::step_media_revalidation_(const TimeBudget &budget)
+    {
+      // A few files at a time, while the iteration's budget lasts
+      static const size_t FILES_PER_STEP = 4;
+      bool done = false;
+      while (!done && !budget.expired())
+      {
+        done = media_index_.revalidate_step(FILES_PER_STEP);
+      }
+
+      if (!done)
+      {
+        return;
+      }
+
+      if (!media_index_.get_removed().empty())
+      {
+        dequeue_media_(media_index_.get_removed());
+      }
+      if (!media_index_.get_added().empty())
+      {
+        enqueue_media_(media_index_.get_added());
+      }
+    }
+
+    void SlideshowComponent::enqueue_media_(const std::vector<std::string> &paths)
+    {
+      // Files already in the queue (e.g. enqueued by an on_refresh handler) are not added twice
+      std::set<std::string> queued;
+      for (const auto &item : queue_)
+      {
+        queued.insert(item.source);
+      }
+
+      std::vector<std::string> fresh;
+      for (const auto &path : paths)
+      {
+        if (queued.insert(path).second)
+        {
+          fresh.push_back(path);
+        }
+      }
+      enqueue(fresh);
+    }
+
+    void SlideshowComponent::dequeue_media_(const std::vector<std::string> &paths)
+    {
+      // Collect ids first; every removal shifts the queue
+      std::set<std::string> removed(paths.begin(), paths.end());
+      std::vector<uint32_t> ids;
+      for (const auto &item : queue_)
+      {
+        if (removed.count(item.source) > 0)
+        {
+          ids.push_back(item.id);
+        }
+      }
+      for (uint32_t id : ids)
+      {
+        remove_item(id);
+      }
+    }
+#endif
+
+    void SlideshowComponent::wake_()
+    {
+      if (!loop_sleeping_ || suspended_)
+      {
+        return;
+      }
+
+      loop_sleeping_ = false;
+      stats_.loop_wakeups++;
+      enable_loop();
     }
 
     bool SlideshowComponent::is_slot_loading_(size_t slot_index)
     {
-      return loading_slots_.find(slot_index) != loading_slots_.end();
+      return pool_->is_loading(slot_index) || pool_->is_pending(slot_index);
     }
 
   } // namespace slideshow
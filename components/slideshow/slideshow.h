@@ -3,10 +3,24 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/http_request/http_request.h"
 #include "esphome/components/image/image.h"
 #include "esphome/components/online_image/online_image.h"
-
+#include "esphome/core/defines.h"
+
+#include "slideshow_budget.h"
+#include "slideshow_frame.h"
+#include "slideshow_slot.h"
+#include "slideshow_pool.h"
+#include "slideshow_media_index.h"
+#include "slideshow_frame_cache.h"
+#include "slideshow_preview.h"
+#include "slideshow_resample.h"
+#include "slideshow_variants.h"
+
+#include <cstddef>
+#include <deque>
 #include <vector>
 #include <map>
 #include <set>
@@ -16,72 +30,71 @@ namespace esphome
 {
   namespace slideshow
   {
-    class OnceCallbackManager
+    struct QueueItem
     {
-    public:
-      /// Add a callback to the list.
-      void add(std::function<void(bool)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
-
-      /// Call all callbacks in this manager.
-      void call(bool arg)
-      {
-        std::vector<std::function<void(bool)>> current_callbacks = std::move(this->callbacks_);
-        this->callbacks_.clear();
-
-        for (auto &cb : current_callbacks)
-        {
-          cb(arg);
-        }
-      }
-      size_t size() const { return this->callbacks_.size(); }
-
-      void clear()
-      {
-        this->callbacks_.clear();
-      }
-
-    protected:
-      std::vector<std::function<void(bool)>> callbacks_;
+      std::string source;
+      uint32_t id{0};        // Stable across paging and edits, unlike the queue index
+      bool priority{false};  // In the play-next lane, not played yet
+#ifdef USE_SLIDESHOW_PREVIEW
+      std::string preview; // BlurHash shown while the source loads, may be empty
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      std::vector<SourceVariant> variants; // Encodings to pick from, smallest first; empty for plain sources
+      uint8_t variant{0};                  // The one loaded (or being loaded)
+#endif
     };
 
-    // Abstract interface for any slot (Online, Local, Generated)
-    class SlideshowSlot
+    // How the advance timer commits to the next item
+    enum AdvanceMode : uint8_t
     {
-    public:
-      virtual ~SlideshowSlot() = default;
-
-      // The slideshow calls this to load new content
-      virtual void set_source(const std::string &source) = 0;
-
-      // Trigger the loading process (download or file read)
-      virtual void update() = 0;
-
-      // Release memory if possible
-      virtual void release() = 0;
-
-      // Return the underlying generic Image for the Display component
-      virtual esphome::image::Image *get_image() = 0;
+      ADVANCE_MODE_IMMEDIATE = 0, // Always advance, even if the next image is still loading
+      ADVANCE_MODE_WHEN_READY,    // Wait for the next image to be ready (up to the grace period)
+    };
 
-      // Status check
-      virtual bool is_ready() = 0;
-      virtual bool is_failed() = 0;
+    // Upper bounds of the loop time histogram buckets; the last bucket is open ended
+    static const size_t LOOP_TIME_BUCKETS = 8;
+    static const uint32_t LOOP_TIME_BOUNDS_US[LOOP_TIME_BUCKETS - 1] = {500, 1000, 2000, 5000, 10000, 20000, 50000};
 
-      void callback_once(std::function<void(bool)> &&cb)
-      {
-        this->callbacks_.add(std::move(cb));
-      }
-
-    protected:
-      // OnceCallbackManager<void(bool)> callbacks_;
-      OnceCallbackManager callbacks_;
+    // Counters for tuning and power measurements
+    struct SlideshowStats
+    {
+      uint32_t loop_iterations{0}; // loop() calls while enabled
+      uint32_t loop_wakeups{0};    // Times an event re-enabled a sleeping loop
+      uint32_t loop_sleeps{0};     // Times the loop disabled itself when idle
+      uint32_t advances{0};
+      uint32_t images_ready{0};
+      uint32_t image_errors{0};
+
+      // Time spent per loop() iteration
+      uint32_t loop_time_histogram[LOOP_TIME_BUCKETS]{};
+      uint32_t loop_time_max_us{0};
+      uint32_t loops_over_budget{0};
     };
 
-    struct QueueItem
+    // Queue position saved to flash for warm restarts. The source hash lets
+    // the position be found again in a queue rebuilt after boot.
+    struct SlideshowCheckpoint
     {
-      std::string source;
+      uint32_t index;
+      uint32_t source_hash;
     };
 
-    using queue_builder_t = std::function<std::vector<std::string>()>;
+#ifdef USE_SLIDESHOW_HANDOFF
+    // A frame as handed to the display: the pixels stay in the slot's buffer
+    struct FrameDescriptor
+    {
+      const uint8_t *data{nullptr}; // nullptr while no frame is staged
+      size_t size{0};
+      int width{0};
+      int height{0};
+      esphome::image::ImageType type{esphome::image::IMAGE_TYPE_RGB565};
+      uint32_t item_id{0};
+      esphome::image::Image *image{nullptr};
+#ifdef USE_LVGL
+      lv_img_dsc_t *lv_img_dsc{nullptr}; // The same pixels, for lv_img_set_src()
+#endif
+    };
+#endif
 
     class SlideshowComponent : public Component
     {
@@ -95,13 +108,81 @@ namespace esphome
       void set_advance_interval(uint32_t ms) { advance_interval_ = ms; }
       void set_refresh_interval(uint32_t ms) { refresh_interval_ = ms; }
       void set_slot_count(size_t count) { slot_count_ = count; }
+      void set_advance_mode(AdvanceMode mode) { advance_mode_ = mode; }
+      void set_ready_grace_period(uint32_t ms) { ready_grace_period_ = ms; }
+      // Items after the current one kept loaded, so a failed or slow one can be skipped
+      void set_prefetch_ahead(size_t count) { prefetch_ahead_ = count > 0 ? count : 1; }
+      // Grow the lookahead past prefetch_ahead while the frames held fit in this many bytes (0 = off)
+      void set_prefetch_memory(size_t bytes) { prefetch_memory_ = bytes; }
+      void set_revalidate(bool revalidate);
+      void set_max_concurrent_loads(size_t max);
+      void set_trace_size(size_t events) { trace_size_ = events; }
+      // Time one loop() iteration may spend before deferring work (0 = unlimited)
+      void set_loop_budget(uint32_t us) { loop_budget_us_ = us; }
+      // Demand paging: request page_size items whenever fewer than watermark
+      // are left unplayed, keeping at most max_resident_pages in the queue
+      void set_page_size(size_t count) { page_size_ = count; }
+      void set_page_watermark(size_t count) { page_watermark_ = count; }
+      void set_max_resident_pages(size_t count) { max_resident_pages_ = count; }
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      // Feed the queue from an indexed media directory (local_image slots)
+      void set_media_directory(const std::string &directory) { media_index_.set_directory(directory); }
+      void set_media_index_file(const std::string &index_file) { media_index_.set_index_file(index_file); }
+      MediaIndex *get_media_index() { return &media_index_; }
+#endif
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      // Restore the queue position (and the last frame, if cached) after a reboot
+      void set_restore_key(const std::string &key) { restore_key_ = fnv1_hash("slideshow_" + key); }
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      void set_frame_cache_path(const std::string &path) { frame_cache_.set_path(path); }
+#endif
+#ifdef USE_SLIDESHOW_FIT
+      // Scale and crop every image into a frame of this display's size
+      void set_fit(int width, int height, FitMode mode)
+      {
+        fit_width_ = width;
+        fit_height_ = height;
+        fit_mode_ = mode;
+      }
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      // Pick among "url size, url size" variants by measured throughput,
+      // assuming initial_throughput (bytes/s) until a load was timed
+      void set_initial_throughput(uint32_t bytes_per_s) { own_pool_.get_throughput()->set_initial(bytes_per_s); }
+      // Load a larger variant of the shown item in the background when time allows
+      void set_variant_upgrade(bool upgrade) { variant_upgrade_ = upgrade; }
+#endif
+#ifdef USE_SLIDESHOW_HANDOFF
+      // Release a swapped out frame anyway if the display never confirms it
+      void set_swap_timeout(uint32_t ms) { swap_timeout_ = ms; }
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      // Resolution previews of "source|blurhash" items are rendered at
+      void set_preview_size(int width, int height)
+      {
+        preview_width_ = width;
+        preview_height_ = height;
+      }
+#endif
 
-      void set_queue_builder(queue_builder_t &&builder) { queue_builder_ = builder; }
+      // Draw slots from another slideshow's pool instead of owning any
+      void set_pool_owner(SlideshowComponent *owner) { pool_owner_ = owner; }
+      SlideshowPool *get_pool();
 
-      void add_image_slot(online_image::OnlineImage *slot);
-      void add_image_slot(esphome::image::Image *slot);
-#ifdef USE_LOCAL_IMAGE
-      void add_image_slot(local_image::LocalImage *slot);
+      // Only overloads for configured slot types exist (see USE_SLIDESHOW_*_SLOT)
+      void reserve_image_slots(size_t count) { own_pool_.reserve(count); }
+#ifdef USE_SLIDESHOW_ONLINE_SLOT
+      void add_image_slot(online_image::OnlineImage *slot) { this->bind_slot_<OnlineImageSlot>(slot); }
+#endif
+#ifdef USE_SLIDESHOW_EMBEDDED_SLOT
+      void add_image_slot(esphome::image::Image *slot) { this->bind_slot_<EmbeddedImageSlot>(slot); }
+#endif
+#ifdef USE_SLIDESHOW_LOCAL_SLOT
+      void add_image_slot(local_image::LocalImage *slot) { this->bind_slot_<LocalImageSlot>(slot); }
+#endif
+#ifdef USE_SLIDESHOW_RAW_SLOT
+      void add_image_slot(RawFrameImage *slot) { this->bind_slot_<RawFrameSlot>(slot); }
 #endif
 
       // Control API
@@ -112,24 +193,62 @@ namespace esphome
       void jump_to(size_t index);
       void refresh();
 
-      void suspend(bool suspend)
-      {
-        suspended_ = suspend;
-      }
+      void suspend(bool suspend);
+
+#ifdef USE_SLIDESHOW_HANDOFF
+      // Frame handoff: the front frame is the one on screen, the back frame
+      // is the next item, staged once it is ready. They swap when the slideshow
+      // advances; the frame swapped out stays pinned in its slot until the
+      // display calls complete_swap().
+      const FrameDescriptor &get_front_frame() const { return frames_[front_frame_]; }
+      const FrameDescriptor &get_back_frame() const { return frames_[front_frame_ ^ 1]; }
+      bool is_swap_pending() const { return swap_pending_; }
+#endif
+      // The display no longer reads the previous front frame
+      void complete_swap();
 
       // State queries
       size_t current_index() const { return current_index_; }
       bool is_paused() const { return paused_; }
+      bool is_advance_pending() const { return advance_pending_; }
       size_t queue_size() const { return queue_.size(); }
+      uint32_t get_item_id(size_t queue_index) const;
+      uint32_t current_item_id() const;
       SlideshowSlot *get_current_image();
       SlideshowSlot *get_slot(size_t slot_index);
+      SlideshowSlot *get_slot_for_index(size_t queue_index);
+      const SlideshowStats &get_stats() const { return stats_; }
+      void log_stats();
+
+      // Event trace, replayable on a host with tools/slideshow_trace.py
+      TraceRecorder *get_trace() { return trace_.get(); }
+      void dump_trace();
+      bool dump_trace_to_file(const std::string &path);
 
       void enqueue(const std::vector<std::string> &items);
       void clear_queue(); // Optional utility
-
-      // Called by online_image callbacks
+      // Answer to on_page_request; an empty next_cursor marks the end of the list
+      void append_page(const std::vector<std::string> &items, const std::string &next_cursor);
+
+      // Queue edits keep loaded frames and loads in flight: slots follow their items by id
+      void insert(size_t position, const std::vector<std::string> &items);
+      // Play-next lane: items play right after the current one (behind earlier
+      // play-next items) and load ahead of the rest of the window
+      void play_next(const std::vector<std::string> &items);
+      bool remove_item(uint32_t item_id);
+      // Move items, in the given order, in front of the item at position (the end if past it).
+      // Returns false, without notifying, if the queue is left as it was.
+      bool splice(const std::vector<uint32_t> &item_ids, size_t position);
+      // Queue index of an item, SIZE_MAX if it is not in the queue
+      size_t find_item(uint32_t item_id) const;
+
+      // Called by the slot pool when a load this slideshow holds completes
       void on_image_ready(size_t slot_index);
       void on_image_error(size_t slot_index);
+      // Called by the slot pool when queued loads can be started
+      void schedule_loads();
+      // Called by the slot pool when a slot released mid-load becomes free
+      void on_slot_freed() { mark_slots_dirty_(); }
 
       // Callbacks
       void add_on_advance_callback(std::function<void(size_t)> &&callback)
@@ -152,16 +271,117 @@ namespace esphome
       {
         on_refresh_callbacks_.add(std::move(callback));
       }
+      void add_on_page_request_callback(std::function<void(std::string, size_t)> &&callback)
+      {
+        on_page_request_callbacks_.add(std::move(callback));
+      }
+      void add_on_frame_swap_callback(std::function<void(size_t)> &&callback)
+      {
+        on_frame_swap_callbacks_.add(std::move(callback));
+      }
 
     protected:
+      template <typename T, typename Img>
+      void bind_slot_(Img *img)
+      {
+        auto *slot = this->own_pool_.add_slot();
+        if (slot != nullptr)
+        {
+          slot->template bind<T>(img);
+        }
+      }
+
       // Queue management
-      void update_queue_from_builder_();
+      QueueItem make_queue_item_(const std::string &str);
+      void check_page_watermark_();
+      void request_page_();
+      void trim_pages_();
+      void drop_front_(size_t count);
+      // Append valid items, as a page of their own or into the newest page; returns how many
+      size_t enqueue_(const std::vector<std::string> &items, bool new_page);
+      void insert_items_(size_t position, const std::vector<std::string> &items, bool priority);
+      void resize_page_(size_t queue_index, ptrdiff_t delta);
+      std::map<uint32_t, size_t> take_slots_by_id_();
+      void rebase_after_edit_(const std::map<uint32_t, size_t> &slots, uint32_t current_id, size_t fallback_index);
+      // What the pool loads for an item: the chosen variant, or the source itself
+      const std::string &load_source_(size_t queue_index) const;
+      uint32_t load_size_hint_(size_t queue_index) const;
+      uint32_t load_trace_key_(size_t queue_index) const;
+
+      // Loop scheduling: the loop only runs while there is work to do, in
+      // resumable steps bounded by the per-iteration budget
+      void run_steps_(const TimeBudget &budget);
+      void record_loop_time_(uint32_t elapsed_us);
+      void mark_slots_dirty_();
+      void mark_needs_more_photos_();
+      void wake_();
+      bool has_pending_work_();
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      void start_media_revalidation_();
+      void step_media_revalidation_(const TimeBudget &budget);
+      void enqueue_media_(const std::vector<std::string> &paths);
+      void dequeue_media_(const std::vector<std::string> &paths);
+#endif
+
+      // Persist the position (and cached frame) after it changed
+      void checkpoint_position_(bool navigated);
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      void save_checkpoint_();
+      void restore_checkpoint_();
+      void step_restore_scan_(const TimeBudget &budget);
+      void apply_restore_(size_t index);
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      void load_warm_frame_();
+      void schedule_frame_cache_();
+      void step_frame_cache_(const TimeBudget &budget);
+      void release_warm_frame_();
+#endif
+#ifdef USE_SLIDESHOW_FIT
+      void start_fit_(bool force);
+      void step_fit_(const TimeBudget &budget);
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      uint32_t time_until_advance_() const;
+      void choose_variant_(size_t queue_index, uint32_t available_ms);
+      void start_upgrade_();
+      void finish_upgrade_();
+      void cancel_upgrade_();
+#endif
+#ifdef USE_SLIDESHOW_HANDOFF
+      bool frame_matches_(uint8_t frame, size_t queue_index) const;
+      void update_handoff_();
+      bool stage_frame_(size_t queue_index);
+      void clear_frame_(uint8_t frame);
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      void start_preview_();
+      void step_preview_(const TimeBudget &budget);
+#endif
+
+      void record_trace_(TraceEventType type, uint16_t flags, uint32_t arg);
+      void record_trace_current_(TraceEventType type, uint16_t flags);
+
+      // Advance handling
+      void step_forward_(size_t steps);
+      // Trace, checkpoint and announce a new current item, then reload slots
+      void finish_navigation_(TraceEventType type, uint16_t flags);
+      void request_advance_();
+      bool try_commit_pending_advance_();
+      void cancel_pending_advance_();
+      size_t find_nearest_ready_step_();
+      size_t next_loadable_step_();
+      void forget_failed_(size_t queue_index);
+      bool is_index_ready_(size_t queue_index);
 
       // Slot management
       void ensure_slots_loaded_();
-      size_t find_free_slot_();
+      void extend_lookahead_(size_t current_index_mod, std::vector<size_t> &ahead);
+      // Tell the pool which slot this slideshow shows
+      void update_displayed_();
+      // Mark the new current frame displayed, then fire on_advance
+      void announce_position_();
       void release_slot_(size_t slot_index);
-      void load_image_to_slot_(size_t queue_index, size_t slot_index);
       bool is_slot_loading_(size_t slot_index);
 
       // State
@@ -170,23 +390,110 @@ namespace esphome
       bool paused_{false};
       bool suspended_{false};
 
+      // Readiness-gated advance
+      AdvanceMode advance_mode_{ADVANCE_MODE_IMMEDIATE};
+      uint32_t ready_grace_period_{30000};
+      bool advance_pending_{false};
+      bool grace_expired_{false};
+      size_t prefetch_ahead_{1};
+      size_t prefetch_memory_{0};
+      // Items whose last load failed. They are not loaded again, and advances
+      // step over them, until they drop behind the window or a refresh.
+      std::set<uint32_t> failed_ids_;
+
       bool needs_more_photos_{false};
       bool slots_dirty_{true}; // Flag to track if slots need reloading
+      bool loop_sleeping_{false};
+      bool loads_scheduled_{false};
+      uint32_t loop_budget_us_{8000};
+      SlideshowStats stats_;
+
+      // Demand paging (page_size_ 0 = off)
+      size_t page_size_{0};
+      size_t page_watermark_{0};
+      size_t max_resident_pages_{0};
+      std::string page_cursor_;         // Cursor of the next page to request
+      std::deque<size_t> page_lengths_; // Items per resident page, oldest first
+      bool page_request_due_{false};
+      bool page_request_in_flight_{false};
+      bool pages_exhausted_{false}; // Provider returned nothing, wait for a refresh
+
+      size_t trace_size_{0};
+      std::unique_ptr<TraceRecorder> trace_;
+
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+      MediaIndex media_index_;
+#endif
 
-      // The Builder Lambda
-      queue_builder_t queue_builder_;
+#ifdef USE_SLIDESHOW_WARM_RESTART
+      uint32_t restore_key_{0};
+      ESPPreferenceObject checkpoint_pref_;
+      SlideshowCheckpoint checkpoint_{0, 0}; // Last saved position
+      bool restore_pending_{false};          // Checkpoint not yet found in the queue
+      size_t restore_scan_pos_{0};           // Next queue index to search for it
+#endif
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+      // Last displayed frame, shown from boot until the real image is ready
+      FrameCache frame_cache_;
+      FrameBuffer warm_frame_;
+      SlideshowSlot warm_slot_;
+      uint32_t warm_hash_{0};
+      bool frame_cache_due_{false};
+#endif
+#ifdef USE_SLIDESHOW_FIT
+      // The current image, fitted to the display
+      int fit_width_{0};
+      int fit_height_{0};
+      FitMode fit_mode_{FIT_MODE_COVER};
+      FrameResampler fit_resampler_;
+      FrameBuffer fit_frame_;
+      SlideshowSlot fit_slot_;
+      uint32_t fit_id_{0}; // Item the frame holds (or is being fitted for)
+      bool fit_ready_{false};
+      bool fit_unsupported_{false}; // Source format the resampler cannot read, shown as is
+      uint32_t fit_render_us_{0};
+#endif
+#ifdef USE_SLIDESHOW_VARIANTS
+      // Background load of a larger variant of the shown item
+      bool variant_upgrade_{true};
+      uint32_t upgrade_id_{0};
+      size_t upgrade_slot_{SIZE_MAX};
+      uint8_t upgrade_variant_{0};
+      uint32_t upgrade_failed_id_{0}; // Not retried for this item
+#endif
+#ifdef USE_SLIDESHOW_HANDOFF
+      // Front and back frames; swapping flips front_frame_, the descriptors stay put
+      FrameDescriptor frames_[2];
+      size_t frame_slots_[2]{SIZE_MAX, SIZE_MAX}; // Pinned pool slot behind each frame
+      uint8_t front_frame_{0};
+      bool swap_pending_{false}; // Back frame is the one swapped out, still pinned
+      uint32_t swap_timeout_{1000};
+#endif
+#ifdef USE_SLIDESHOW_PREVIEW
+      // BlurHash of the current item, shown until its image is ready
+      int preview_width_{0};
+      int preview_height_{0};
+      BlurHashDecoder preview_decoder_;
+      FrameBuffer preview_frame_;
+      SlideshowSlot preview_slot_;
+      uint32_t preview_id_{0}; // Item the frame holds (or is being rendered for)
+      bool preview_ready_{false};
+      uint32_t preview_render_us_{0};
+#endif
 
       // Queue data
       std::vector<QueueItem> queue_;
       size_t current_index_{0};
+      uint32_t next_item_id_{1};
 
-      // Image slots
-      std::vector<std::unique_ptr<SlideshowSlot>> image_slots_;
+      // Image slots, owned here unless borrowed from another slideshow
+      SlideshowPool own_pool_;
+      SlideshowComponent *pool_owner_{nullptr};
+      SlideshowPool *pool_{&own_pool_};
       size_t slot_count_{0};
 
-      // Mapping: queue_index -> slot_index
+      // Mapping: queue_index -> pool slot_index
       std::map<size_t, size_t> loaded_images_;
-      std::set<size_t> loading_slots_;
 
       // Timing
       uint32_t last_advance_{0};
@@ -198,6 +505,8 @@ namespace esphome
       CallbackManager<void(size_t)> on_queue_updated_callbacks_;
       CallbackManager<void(std::string)> on_error_callbacks_;
       CallbackManager<void(size_t)> on_refresh_callbacks_;
+      CallbackManager<void(std::string, size_t)> on_page_request_callbacks_;
+      CallbackManager<void(size_t)> on_frame_swap_callbacks_;
     };
 
     // Triggers
@@ -251,6 +560,26 @@ namespace esphome
       }
     };
 
+    class OnPageRequestTrigger : public Trigger<std::string, size_t>
+    {
+    public:
+      explicit OnPageRequestTrigger(SlideshowComponent *parent)
+      {
+        parent->add_on_page_request_callback([this](std::string cursor, size_t count)
+                                             { this->trigger(cursor, count); });
+      }
+    };
+
+    class OnFrameSwapTrigger : public Trigger<size_t>
+    {
+    public:
+      explicit OnFrameSwapTrigger(SlideshowComponent *parent)
+      {
+        parent->add_on_frame_swap_callback([this](size_t index)
+                                           { this->trigger(index); });
+      }
+    };
+
     // Actions
     template <typename... Ts>
     class AdvanceAction : public Action<Ts...>
@@ -325,6 +654,60 @@ namespace esphome
       std::vector<std::string> items_;
     };
     
+    template <typename... Ts>
+    class AppendPageAction : public Action<Ts...>
+    {
+    public:
+      explicit AppendPageAction(SlideshowComponent *parent) : parent_(parent) {}
+      TEMPLATABLE_VALUE(std::vector<std::string>, items)
+      TEMPLATABLE_VALUE(std::string, next_cursor)
+
+      void play(const Ts &...x) override
+      {
+        this->parent_->append_page(this->items_.value(x...), this->next_cursor_.value(x...));
+      }
+
+    protected:
+      SlideshowComponent *parent_;
+    };
+
+    template <typename... Ts>
+    class CompleteSwapAction : public Action<Ts...>
+    {
+    public:
+      explicit CompleteSwapAction(SlideshowComponent *slideshow) : slideshow_(slideshow) {}
+      void play(const Ts &...x) override { this->slideshow_->complete_swap(); }
+
+    protected:
+      SlideshowComponent *slideshow_;
+    };
+
+    template <typename... Ts>
+    class PlayNextAction : public Action<Ts...>
+    {
+    public:
+      explicit PlayNextAction(SlideshowComponent *parent) : parent_(parent) {}
+      TEMPLATABLE_VALUE(std::vector<std::string>, items)
+
+      void play(const Ts &...x) override { this->parent_->play_next(this->items_.value(x...)); }
+
+    protected:
+      SlideshowComponent *parent_;
+    };
+
+    template <typename... Ts>
+    class RemoveItemAction : public Action<Ts...>
+    {
+    public:
+      explicit RemoveItemAction(SlideshowComponent *parent) : parent_(parent) {}
+      TEMPLATABLE_VALUE(uint32_t, item_id)
+
+      void play(const Ts &...x) override { this->parent_->remove_item(this->item_id_.value(x...)); }
+
+    protected:
+      SlideshowComponent *parent_;
+    };
+
     template <typename... Ts>
     class SuspendAction : public Action<Ts...>
     {
@@ -344,5 +727,29 @@ namespace esphome
       SlideshowComponent *slideshow_;
     };
 
+    template <typename... Ts>
+    class DumpTraceAction : public Action<Ts...>
+    {
+    public:
+      explicit DumpTraceAction(SlideshowComponent *slideshow) : slideshow_(slideshow) {}
+      TEMPLATABLE_VALUE(std::string, path)
+
+      void play(const Ts &...x) override
+      {
+        // Without a path the trace goes to the logger
+        if (this->path_.has_value())
+        {
+          this->slideshow_->dump_trace_to_file(this->path_.value(x...));
+        }
+        else
+        {
+          this->slideshow_->dump_trace();
+        }
+      }
+
+    protected:
+      SlideshowComponent *slideshow_;
+    };
+
   } // namespace slideshow
 } // namespace esphome
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "esphome/core/hal.h"
+
+#include <cstdint>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Time allowance for one loop() iteration. Resumable work checks it
+    // between steps and picks up where it left off on the next iteration.
+    class TimeBudget
+    {
+    public:
+      explicit TimeBudget(uint32_t budget_us) : start_(micros()), budget_us_(budget_us) {}
+
+      // A budget of 0 never expires
+      bool expired() const { return this->budget_us_ != 0 && this->elapsed_us() >= this->budget_us_; }
+      uint32_t elapsed_us() const { return micros() - this->start_; }
+
+    protected:
+      uint32_t start_;
+      uint32_t budget_us_;
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    class OnceCallbackManager
+    {
+    public:
+      /// Add a callback to the list.
+      void add(std::function<void(bool)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+
+      /// Call all callbacks in this manager.
+      void call(bool arg)
+      {
+        std::vector<std::function<void(bool)>> current_callbacks = std::move(this->callbacks_);
+        this->callbacks_.clear();
+
+        for (auto &cb : current_callbacks)
+        {
+          cb(arg);
+        }
+      }
+      size_t size() const { return this->callbacks_.size(); }
+
+      void clear()
+      {
+        this->callbacks_.clear();
+      }
+
+    protected:
+      std::vector<std::function<void(bool)>> callbacks_;
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -1,52 +1,82 @@
 #pragma once
 
-#include "esphome/core/component.h"
+#include "esphome/core/log.h"
+#include "esphome/components/image/image.h"
 
-#include "slideshow.h"
+#include "slideshow_callbacks.h"
+#include "slideshow_validators.h"
+
+#include <string>
 
 namespace esphome
 {
   namespace slideshow
   {
-    class EmbeddedImageSlot : public SlideshowSlot
+    class EmbeddedImageSlot
     {
     public:
-      EmbeddedImageSlot(esphome::image::Image *img) : img_(img) {}
+      EmbeddedImageSlot(esphome::image::Image *img, OnceCallbackManager *callbacks) : img_(img), callbacks_(callbacks) {}
 
-      void set_source(const std::string &source) override
+      void set_source(const std::string &source)
       {
         // Translate the generic source into what local_image expects
         ESP_LOGE("slideshow", "EmbeddedImageSlot does not support set_source with string. Source: %s", source.c_str());
       }
 
-      void update() override
+      void update()
       {
-        this->callbacks_.call(true);
+        this->callbacks_->call(true);
       }
 
-      void release() override
+      void revalidate(const HttpValidators &validators)
+      {
+        this->update();
+      }
+
+      void release()
       {
         ESP_LOGI("slideshow", "EmbeddedImageSlot does not support release. Image cannot be released.");
       }
 
-      esphome::image::Image *get_image() override
+      void set_displayed(bool displayed)
+      {
+        // The pixels are read from flash in place
+      }
+
+      size_t get_resident_bytes()
+      {
+        return 0;
+      }
+
+      esphome::image::Image *get_image()
       {
         return this->img_;
       }
 
-      bool is_ready() override
+      bool is_ready()
       {
         return true;
       }
 
-      bool is_failed() override
+      bool is_failed()
+      {
+        return false;
+      }
+
+      bool was_cached()
       {
         return false;
       }
 
+      HttpValidators get_validators()
+      {
+        return {};
+      }
+
     protected:
       esphome::image::Image *img_;
+      OnceCallbackManager *callbacks_;
     };
 
   } // namespace slideshow
-} // namespace esphome
\ No newline at end of file
+} // namespace esphome
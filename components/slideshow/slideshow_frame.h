@@ -0,0 +1,100 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include "esphome/components/image/image.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Size in bytes of a pixel buffer of the given dimensions and type
+    inline size_t frame_bytes(int width, int height, esphome::image::ImageType type)
+    {
+      if (width <= 0 || height <= 0)
+      {
+        return 0;
+      }
+
+      size_t w = width;
+      size_t h = height;
+      switch (type)
+      {
+      case esphome::image::IMAGE_TYPE_BINARY:
+        return (w + 7) / 8 * h;
+      case esphome::image::IMAGE_TYPE_GRAYSCALE:
+        return w * h;
+      case esphome::image::IMAGE_TYPE_RGB565:
+        return w * h * 2;
+      case esphome::image::IMAGE_TYPE_RGB:
+        return w * h * 3;
+      default:
+        return 0;
+      }
+    }
+
+    // Size in bytes of an image's pixel buffer, derived from its type
+    inline size_t image_frame_bytes(esphome::image::Image *img)
+    {
+      if (img == nullptr)
+      {
+        return 0;
+      }
+      return frame_bytes(img->get_width(), img->get_height(), img->get_type());
+    }
+
+    // Pixel buffer owned by the slideshow (PSRAM when available), exposed as
+    // an image::Image so it can be drawn like any slot image.
+    class FrameBuffer
+    {
+    public:
+      FrameBuffer() = default;
+      FrameBuffer(const FrameBuffer &) = delete;
+      FrameBuffer &operator=(const FrameBuffer &) = delete;
+      ~FrameBuffer() { this->free(); }
+
+      bool allocate(int width, int height, esphome::image::ImageType type)
+      {
+        this->free();
+
+        size_t size = frame_bytes(width, height, type);
+        if (size == 0)
+          return false;
+
+        this->data_ = this->allocator_.allocate(size);
+        if (this->data_ == nullptr)
+          return false;
+
+        this->size_ = size;
+        this->image_.reset(new esphome::image::Image(this->data_, width, height, type, esphome::image::TRANSPARENCY_OPAQUE));
+        return true;
+      }
+
+      void free()
+      {
+        this->image_.reset();
+        if (this->data_ != nullptr)
+        {
+          this->allocator_.deallocate(this->data_, this->size_);
+          this->data_ = nullptr;
+          this->size_ = 0;
+        }
+      }
+
+      bool is_allocated() const { return this->data_ != nullptr; }
+      uint8_t *data() { return this->data_; }
+      size_t size() const { return this->size_; }
+      esphome::image::Image *get_image() { return this->image_.get(); }
+
+    protected:
+      RAMAllocator<uint8_t> allocator_;
+      uint8_t *data_{nullptr};
+      size_t size_{0};
+      std::unique_ptr<esphome::image::Image> image_;
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -0,0 +1,172 @@
+#include "slideshow_frame_cache.h"
+
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+
+    static const char *const TAG = "slideshow.frame_cache";
+
+    static const uint32_t FRAME_CACHE_MAGIC = 0x43465353; // "SSFC"
+    static const uint8_t FRAME_CACHE_VERSION = 1;
+
+    struct FrameCacheHeader
+    {
+      uint32_t magic;
+      uint8_t version;
+      uint8_t type; // image::ImageType
+      uint16_t reserved;
+      uint16_t width;
+      uint16_t height;
+      uint32_t source_hash;
+      uint32_t size; // Pixel bytes following the header
+    } __attribute__((packed));
+
+    bool FrameCache::begin_write(esphome::image::Image *img, uint32_t source_hash)
+    {
+      this->abort_write();
+
+      size_t size = image_frame_bytes(img);
+      if (size == 0 || img->get_data_start() == nullptr || img->has_transparency())
+      {
+        ESP_LOGD(TAG, "Frame cannot be cached (unsupported type or empty)");
+        return false;
+      }
+
+      // Write a temporary file and swap it in, so a power cut never leaves a torn frame
+      std::string tmp_path = this->path_ + ".tmp";
+      this->file_ = fopen(tmp_path.c_str(), "wb");
+      if (this->file_ == nullptr)
+      {
+        ESP_LOGW(TAG, "Cannot write %s", tmp_path.c_str());
+        return false;
+      }
+
+      FrameCacheHeader header{FRAME_CACHE_MAGIC, FRAME_CACHE_VERSION, static_cast<uint8_t>(img->get_type()), 0,
+                              static_cast<uint16_t>(img->get_width()), static_cast<uint16_t>(img->get_height()),
+                              source_hash, static_cast<uint32_t>(size)};
+      if (fwrite(&header, sizeof(header), 1, this->file_) != 1)
+      {
+        this->abort_write();
+        return false;
+      }
+
+      this->data_ = img->get_data_start();
+      this->size_ = size;
+      this->written_ = 0;
+      this->writing_hash_ = source_hash;
+      return true;
+    }
+
+    bool FrameCache::write_step(size_t max_bytes)
+    {
+      if (this->file_ == nullptr)
+      {
+        return true;
+      }
+
+      size_t count = std::min(max_bytes, this->size_ - this->written_);
+      if (fwrite(this->data_ + this->written_, count, 1, this->file_) != 1)
+      {
+        ESP_LOGW(TAG, "Failed to write frame cache %s", this->path_.c_str());
+        this->abort_write();
+        return true;
+      }
+      this->written_ += count;
+      if (this->written_ < this->size_)
+      {
+        return false;
+      }
+
+      std::string tmp_path = this->path_ + ".tmp";
+      bool ok = fclose(this->file_) == 0;
+      this->file_ = nullptr;
+      this->data_ = nullptr;
+      if (ok && rename(tmp_path.c_str(), this->path_.c_str()) != 0)
+      {
+        // FAT cannot rename over an existing file. Until the rename below
+        // the temporary file is the cache, and read() falls back to it.
+        remove(this->path_.c_str());
+        ok = rename(tmp_path.c_str(), this->path_.c_str()) == 0;
+      }
+      if (!ok)
+      {
+        ESP_LOGW(TAG, "Failed to write frame cache %s", this->path_.c_str());
+        remove(tmp_path.c_str());
+        return true;
+      }
+
+      this->cached_hash_ = this->writing_hash_;
+      ESP_LOGD(TAG, "Cached frame (%u bytes)", this->size_);
+      return true;
+    }
+
+    void FrameCache::abort_write()
+    {
+      if (this->file_ == nullptr)
+      {
+        return;
+      }
+      fclose(this->file_);
+      this->file_ = nullptr;
+      this->data_ = nullptr;
+      remove((this->path_ + ".tmp").c_str());
+    }
+
+    uint32_t FrameCache::read(FrameBuffer &frame)
+    {
+      uint32_t source_hash = read_file_(path_, frame);
+      if (source_hash != 0)
+      {
+        return source_hash;
+      }
+
+      // Power lost during a write on FAT, after the old frame was removed:
+      // a complete temporary file is the new one
+      std::string tmp_path = path_ + ".tmp";
+      source_hash = read_file_(tmp_path, frame);
+      if (source_hash != 0)
+      {
+        rename(tmp_path.c_str(), path_.c_str());
+      }
+      return source_hash;
+    }
+
+    uint32_t FrameCache::read_file_(const std::string &path, FrameBuffer &frame)
+    {
+      FILE *file = fopen(path.c_str(), "rb");
+      if (file == nullptr)
+      {
+        return 0;
+      }
+
+      FrameCacheHeader header;
+      bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == FRAME_CACHE_MAGIC &&
+                header.version == FRAME_CACHE_VERSION &&
+                frame.allocate(header.width, header.height, static_cast<esphome::image::ImageType>(header.type)) &&
+                frame.size() == header.size && fread(frame.data(), header.size, 1, file) == 1;
+      fclose(file);
+
+      if (!ok)
+      {
+        ESP_LOGW(TAG, "Ignoring unreadable frame cache %s", path.c_str());
+        frame.free();
+        return 0;
+      }
+
+      cached_hash_ = header.source_hash;
+      ESP_LOGI(TAG, "Restored %dx%d frame from %s", header.width, header.height, path.c_str());
+      return header.source_hash;
+    }
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
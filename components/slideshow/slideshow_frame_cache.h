@@ -0,0 +1,56 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SLIDESHOW_FRAME_CACHE
+
+#include "slideshow_frame.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // The last displayed frame, stored raw on a filesystem (SD card) so it can
+    // be shown at boot before the network and the first download are up.
+    class FrameCache
+    {
+    public:
+      void set_path(const std::string &path) { path_ = path; }
+      const std::string &get_path() const { return path_; }
+
+      // Store the pixels of `img`, tagged with the hash of its source. The
+      // write is incremental: call write_step() until it returns true. The
+      // image must stay loaded until then, or the write must be aborted.
+      bool begin_write(esphome::image::Image *img, uint32_t source_hash);
+      bool write_step(size_t max_bytes);
+      void abort_write();
+      bool is_writing() const { return this->file_ != nullptr; }
+      const uint8_t *get_write_data() const { return this->data_; }
+
+      // Read the stored frame into `frame`; returns the source hash, 0 if none
+      uint32_t read(FrameBuffer &frame);
+
+      uint32_t get_cached_hash() const { return cached_hash_; }
+
+    protected:
+      uint32_t read_file_(const std::string &path, FrameBuffer &frame);
+
+      std::string path_;
+      uint32_t cached_hash_{0}; // Source hash of what is on the card
+
+      // Write in progress
+      FILE *file_{nullptr};
+      const uint8_t *data_{nullptr};
+      size_t size_{0};
+      size_t written_{0};
+      uint32_t writing_hash_{0};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -1,62 +1,96 @@
 #pragma once
 
-#include "slideshow.h"
+#include "esphome/core/defines.h"
 
 #ifdef USE_LOCAL_IMAGE
 
 #include "esphome/components/local_image/local_image.h"
 
+#include "slideshow_callbacks.h"
+#include "slideshow_frame.h"
+#include "slideshow_validators.h"
+
 namespace esphome
 {
   namespace slideshow
   {
-    class LocalImageSlot : public SlideshowSlot
+    class LocalImageSlot
     {
     public:
-      LocalImageSlot(local_image::LocalImage *img) : img_(img)
+      LocalImageSlot(local_image::LocalImage *img, OnceCallbackManager *callbacks) : img_(img), callbacks_(callbacks)
       {
         this->img_->add_on_finished_callback([this](bool success)
-                                             { this->callbacks_.call(true); });
+                                             { this->callbacks_->call(true); });
         this->img_->add_on_error_callback([this]()
-                                          { this->callbacks_.call(false); });
+                                          { this->callbacks_->call(false); });
       }
 
-      void set_source(const std::string &source) override
+      // The callbacks above point at this adapter, so it must never be copied or moved
+      LocalImageSlot(const LocalImageSlot &) = delete;
+      LocalImageSlot &operator=(const LocalImageSlot &) = delete;
+
+      void set_source(const std::string &source)
       {
         // Translate the generic source into what local_image expects
         this->img_->set_file_path(source);
       }
 
-      void update() override
+      void update()
       {
         this->img_->load(); // Assuming it has a load/update method
       }
 
-      void release() override
+      void revalidate(const HttpValidators &validators)
+      {
+        this->update();
+      }
+
+      void release()
       {
         this->img_->release();
       }
 
-      esphome::image::Image *get_image() override
+      void set_displayed(bool displayed)
+      {
+        // local_image decodes into its own buffer, which stays as it is
+      }
+
+      size_t get_resident_bytes()
+      {
+        return this->is_ready() ? image_frame_bytes(this->img_) : 0;
+      }
+
+      esphome::image::Image *get_image()
       {
         return this->img_;
       }
 
-      bool is_ready() override
+      bool is_ready()
       {
         return this->img_->get_width() > 0;
       }
 
-      bool is_failed() override
+      bool is_failed()
       {
         return this->img_->get_width() == 0;
       }
 
+      bool was_cached()
+      {
+        return false;
+      }
+
+      HttpValidators get_validators()
+      {
+        return {};
+      }
+
     protected:
       local_image::LocalImage *img_;
+      OnceCallbackManager *callbacks_;
     };
 
   } // namespace slideshow
 } // namespace esphome
 
-#endif
\ No newline at end of file
+#endif
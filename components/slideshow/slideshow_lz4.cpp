@@ -0,0 +1,184 @@
+#include "slideshow_lz4.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+
+    static const uint8_t LZ4_RUN_MASK = 15;
+    static const size_t LZ4_MIN_MATCH = 4;
+    // Input that always holds a token, up to 14 literals and an offset
+    static const ptrdiff_t LZ4_FAST_INPUT = 1 + 14 + 2;
+
+    void Lz4StreamDecoder::reset(uint8_t *out, size_t out_size)
+    {
+      this->out_ = out;
+      this->out_size_ = out_size;
+      this->out_pos_ = 0;
+      this->state_ = STATE_TOKEN;
+      this->token_ = 0;
+      this->length_ = 0;
+      this->offset_ = 0;
+    }
+
+    bool Lz4StreamDecoder::feed(const uint8_t *in, size_t len)
+    {
+      const uint8_t *end = in + len;
+
+      while (in < end)
+      {
+        // Fast path: a whole short sequence is in this chunk, so it is decoded
+        // without going through the states one byte at a time
+        if (this->state_ == STATE_TOKEN && end - in >= LZ4_FAST_INPUT)
+        {
+          uint8_t token = *in;
+          size_t literals = token >> 4;
+          size_t match = (token & LZ4_RUN_MASK) + LZ4_MIN_MATCH;
+          size_t room = this->out_size_ - this->out_pos_;
+          if (literals != LZ4_RUN_MASK && (token & LZ4_RUN_MASK) != LZ4_RUN_MASK && literals + match <= room)
+          {
+            uint8_t *dst = this->out_ + this->out_pos_;
+            memcpy(dst, in + 1, literals);
+            dst += literals;
+            in += 1 + literals;
+            uint16_t offset = in[0] | in[1] << 8;
+            in += 2;
+            size_t produced = this->out_pos_ + literals;
+            if (offset == 0 || offset > produced)
+            {
+              return false;
+            }
+            const uint8_t *src = dst - offset;
+            if (offset >= match)
+            {
+              memcpy(dst, src, match);
+            }
+            else
+            {
+              for (size_t i = 0; i < match; i++)
+              {
+                dst[i] = src[i];
+              }
+            }
+            this->out_pos_ = produced + match;
+            continue;
+          }
+        }
+
+        switch (this->state_)
+        {
+        case STATE_TOKEN:
+          if (this->out_pos_ == this->out_size_)
+          {
+            return false; // Data past the end of the frame
+          }
+          this->token_ = *in++;
+          this->length_ = this->token_ >> 4;
+          this->state_ = this->length_ == LZ4_RUN_MASK ? STATE_LITERAL_LENGTH : STATE_LITERALS;
+          break;
+
+        case STATE_LITERAL_LENGTH:
+        {
+          uint8_t extra = *in++;
+          this->length_ += extra;
+          if (extra != 255)
+          {
+            this->state_ = STATE_LITERALS;
+          }
+          break;
+        }
+
+        case STATE_LITERALS:
+        {
+          size_t count = std::min<size_t>(this->length_, end - in);
+          if (count > this->out_size_ - this->out_pos_)
+          {
+            return false;
+          }
+          memcpy(this->out_ + this->out_pos_, in, count);
+          in += count;
+          this->out_pos_ += count;
+          this->length_ -= count;
+          if (this->length_ == 0)
+          {
+            // The last sequence of a block is literals only
+            this->state_ = this->out_pos_ == this->out_size_ ? STATE_TOKEN : STATE_OFFSET_LOW;
+          }
+          break;
+        }
+
+        case STATE_OFFSET_LOW:
+          this->offset_ = *in++;
+          this->state_ = STATE_OFFSET_HIGH;
+          break;
+
+        case STATE_OFFSET_HIGH:
+          this->offset_ |= static_cast<uint16_t>(*in++) << 8;
+          if (this->offset_ == 0 || this->offset_ > this->out_pos_)
+          {
+            return false;
+          }
+          this->length_ = this->token_ & LZ4_RUN_MASK;
+          if (this->length_ == LZ4_RUN_MASK)
+          {
+            this->state_ = STATE_MATCH_LENGTH;
+          }
+          else if (!this->copy_match_())
+          {
+            return false;
+          }
+          break;
+
+        case STATE_MATCH_LENGTH:
+        {
+          uint8_t extra = *in++;
+          this->length_ += extra;
+          if (extra != 255 && !this->copy_match_())
+          {
+            return false;
+          }
+          break;
+        }
+        }
+      }
+
+      // A literal run of zero length needs no input to finish
+      if (this->state_ == STATE_LITERALS && this->length_ == 0)
+      {
+        this->state_ = this->out_pos_ == this->out_size_ ? STATE_TOKEN : STATE_OFFSET_LOW;
+      }
+      return true;
+    }
+
+    bool Lz4StreamDecoder::copy_match_()
+    {
+      size_t count = this->length_ + LZ4_MIN_MATCH;
+      if (count > this->out_size_ - this->out_pos_)
+      {
+        return false;
+      }
+
+      uint8_t *dst = this->out_ + this->out_pos_;
+      const uint8_t *src = dst - this->offset_;
+      if (this->offset_ >= count)
+      {
+        memcpy(dst, src, count);
+      }
+      else
+      {
+        // Byte by byte: the match overlaps the bytes it produces
+        for (size_t i = 0; i < count; i++)
+        {
+          dst[i] = src[i];
+        }
+      }
+      this->out_pos_ += count;
+      this->state_ = STATE_TOKEN;
+      return true;
+    }
+
+  } // namespace slideshow
+} // namespace esphome
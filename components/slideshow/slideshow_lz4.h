@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Streaming decoder for one LZ4 block. Input may arrive in chunks of any
+    // size; output goes straight into the destination buffer, which doubles
+    // as the match window, so no intermediate buffer is needed.
+    class Lz4StreamDecoder
+    {
+    public:
+      void reset(uint8_t *out, size_t out_size);
+
+      // Decode the next chunk of compressed input. Returns false on corrupt data.
+      bool feed(const uint8_t *in, size_t len);
+
+      bool is_complete() const { return this->out_pos_ == this->out_size_ && this->state_ == STATE_TOKEN; }
+      size_t get_output_size() const { return this->out_pos_; }
+
+    protected:
+      enum State : uint8_t
+      {
+        STATE_TOKEN,
+        STATE_LITERAL_LENGTH,
+        STATE_LITERALS,
+        STATE_OFFSET_LOW,
+        STATE_OFFSET_HIGH,
+        STATE_MATCH_LENGTH,
+      };
+
+      bool copy_match_();
+
+      uint8_t *out_{nullptr};
+      size_t out_size_{0};
+      size_t out_pos_{0};
+
+      State state_{STATE_TOKEN};
+      uint8_t token_{0};
+      size_t length_{0};
+      uint16_t offset_{0};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
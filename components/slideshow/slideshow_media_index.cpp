@@ -0,0 +1,331 @@
+#include "slideshow_media_index.h"
+
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+
+#include "esphome/core/log.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+
+    static const char *const TAG = "slideshow.index";
+
+    static const uint32_t INDEX_MAGIC = 0x58495353; // "SSIX"
+    static const uint16_t INDEX_VERSION = 1;
+
+    // On-card layout, little endian:
+    //   header: magic u32, version u16, reserved u16, count u32
+    //   entry:  size u32, mtime u32, width u16, height u16, name_len u8, name
+    struct IndexHeader
+    {
+      uint32_t magic;
+      uint16_t version;
+      uint16_t reserved;
+      uint32_t count;
+    } __attribute__((packed));
+
+    struct IndexRecord
+    {
+      uint32_t size;
+      uint32_t mtime;
+      uint16_t width;
+      uint16_t height;
+      uint8_t name_len;
+    } __attribute__((packed));
+
+    std::string MediaIndex::get_index_file() const
+    {
+      if (!index_file_.empty())
+      {
+        return index_file_;
+      }
+      return directory_ + "/.slideshow.idx";
+    }
+
+    bool MediaIndex::load()
+    {
+      std::string path = get_index_file();
+      if (load_file_(path))
+      {
+        return true;
+      }
+
+      // Power lost during a save on FAT, after the old index was removed:
+      // the new one is complete in the temporary file
+      std::string tmp_path = path + ".tmp";
+      if (load_file_(tmp_path))
+      {
+        remove(path.c_str());
+        rename(tmp_path.c_str(), path.c_str());
+        return true;
+      }
+      ESP_LOGI(TAG, "No index at %s, it will be built in the background", path.c_str());
+      return false;
+    }
+
+    bool MediaIndex::load_file_(const std::string &path)
+    {
+      FILE *file = fopen(path.c_str(), "rb");
+      if (file == nullptr)
+      {
+        ESP_LOGD(TAG, "No index at %s", path.c_str());
+        return false;
+      }
+
+      IndexHeader header;
+      bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == INDEX_MAGIC &&
+                header.version == INDEX_VERSION;
+
+      std::vector<Entry> entries;
+      if (ok)
+      {
+        entries.reserve(header.count);
+      }
+
+      char name[256];
+      for (uint32_t i = 0; ok && i < header.count; i++)
+      {
+        IndexRecord record;
+        if (fread(&record, sizeof(record), 1, file) != 1 || fread(name, record.name_len, 1, file) != 1)
+        {
+          ok = false;
+          break;
+        }
+
+        Entry entry;
+        entry.name.assign(name, record.name_len);
+        entry.size = record.size;
+        entry.mtime = record.mtime;
+        entry.width = record.width;
+        entry.height = record.height;
+        entries.push_back(std::move(entry));
+      }
+      fclose(file);
+
+      if (!ok)
+      {
+        ESP_LOGW(TAG, "Ignoring corrupt index %s", path.c_str());
+        return false;
+      }
+
+      entries_ = std::move(entries);
+      std::sort(entries_.begin(), entries_.end(), [](const Entry &a, const Entry &b)
+                { return a.name < b.name; });
+      ESP_LOGI(TAG, "Loaded %d entries from %s", entries_.size(), path.c_str());
+      return true;
+    }
+
+    bool MediaIndex::save()
+    {
+      // Write a temporary file and rename it over the index, so a power cut
+      // never leaves a torn one
+      std::string path = get_index_file();
+      std::string tmp_path = path + ".tmp";
+      FILE *file = fopen(tmp_path.c_str(), "wb");
+      if (file == nullptr)
+      {
+        ESP_LOGE(TAG, "Cannot write %s", tmp_path.c_str());
+        return false;
+      }
+
+      IndexHeader header{INDEX_MAGIC, INDEX_VERSION, 0, static_cast<uint32_t>(entries_.size())};
+      bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+      for (const auto &entry : entries_)
+      {
+        if (!ok)
+          break;
+        IndexRecord record{entry.size, entry.mtime, entry.width, entry.height,
+                           static_cast<uint8_t>(entry.name.size())};
+        ok = fwrite(&record, sizeof(record), 1, file) == 1 &&
+             fwrite(entry.name.data(), entry.name.size(), 1, file) == 1;
+      }
+      ok = fclose(file) == 0 && ok;
+      if (!ok)
+      {
+        ESP_LOGE(TAG, "Failed to write index %s", tmp_path.c_str());
+        remove(tmp_path.c_str());
+        return false;
+      }
+
+      if (rename(tmp_path.c_str(), path.c_str()) != 0)
+      {
+        // FAT cannot rename over an existing file. Until the rename below
+        // the temporary file is the index, and load() falls back to it.
+        remove(path.c_str());
+        if (rename(tmp_path.c_str(), path.c_str()) != 0)
+        {
+          ESP_LOGE(TAG, "Failed to replace index %s", path.c_str());
+          return false;
+        }
+      }
+
+      ESP_LOGD(TAG, "Saved %d entries to %s", entries_.size(), path.c_str());
+      return true;
+    }
+
+    void MediaIndex::set_dimensions(const std::string &path, uint16_t width, uint16_t height)
+    {
+      if (path.size() <= directory_.size() + 1 || path.compare(0, directory_.size(), directory_) != 0)
+      {
+        return;
+      }
+
+      Entry *entry = find_(path.substr(directory_.size() + 1));
+      if (entry != nullptr && (entry->width != width || entry->height != height))
+      {
+        entry->width = width;
+        entry->height = height;
+        changed_ = true;
+      }
+    }
+
+    bool MediaIndex::begin_revalidate()
+    {
+      if (dir_ != nullptr)
+      {
+        return true;
+      }
+
+      dir_ = opendir(directory_.c_str());
+      if (dir_ == nullptr)
+      {
+        ESP_LOGW(TAG, "Cannot open directory %s", directory_.c_str());
+        return false;
+      }
+
+      seen_.assign(entries_.size(), false);
+      found_.clear();
+      added_.clear();
+      removed_.clear();
+      return true;
+    }
+
+    bool MediaIndex::revalidate_step(size_t max_files)
+    {
+      if (dir_ == nullptr)
+      {
+        return true;
+      }
+
+      for (size_t i = 0; i < max_files; i++)
+      {
+        struct dirent *ent = readdir(dir_);
+        if (ent == nullptr)
+        {
+          finish_revalidate_();
+          return true;
+        }
+
+        if (ent->d_name[0] == '.' || !is_media_file_(ent->d_name) || strlen(ent->d_name) > 255)
+        {
+          continue;
+        }
+
+        std::string name = ent->d_name;
+        struct stat st;
+        if (stat((directory_ + "/" + name).c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+        {
+          continue;
+        }
+
+        Entry *entry = find_(name);
+        if (entry != nullptr)
+        {
+          seen_[entry - entries_.data()] = true;
+          if (entry->size != static_cast<uint32_t>(st.st_size) || entry->mtime != static_cast<uint32_t>(st.st_mtime))
+          {
+            // Content changed; dimensions have to be learned again
+            entry->size = st.st_size;
+            entry->mtime = st.st_mtime;
+            entry->width = 0;
+            entry->height = 0;
+            changed_ = true;
+          }
+          continue;
+        }
+
+        Entry added;
+        added.name = name;
+        added.size = st.st_size;
+        added.mtime = st.st_mtime;
+        found_.push_back(std::move(added));
+      }
+
+      return false;
+    }
+
+    void MediaIndex::finish_revalidate_()
+    {
+      closedir(dir_);
+      dir_ = nullptr;
+
+      // Drop files that disappeared, merge in new ones
+      std::vector<Entry> entries;
+      entries.reserve(entries_.size() + found_.size());
+      for (size_t i = 0; i < entries_.size(); i++)
+      {
+        if (seen_[i])
+        {
+          entries.push_back(std::move(entries_[i]));
+        }
+        else
+        {
+          removed_.push_back(full_path(entries_[i]));
+        }
+      }
+      for (auto &entry : found_)
+      {
+        added_.push_back(full_path(entry));
+        entries.push_back(std::move(entry));
+      }
+      std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                { return a.name < b.name; });
+
+      entries_ = std::move(entries);
+      seen_.clear();
+      found_.clear();
+
+      ESP_LOGI(TAG, "Revalidated %s: %d files, %d added, %d removed", directory_.c_str(), entries_.size(),
+               added_.size(), removed_.size());
+
+      if (changed_ || !removed_.empty() || !added_.empty())
+      {
+        changed_ = false;
+        save();
+      }
+    }
+
+    MediaIndex::Entry *MediaIndex::find_(const std::string &name)
+    {
+      auto it = std::lower_bound(entries_.begin(), entries_.end(), name, [](const Entry &entry, const std::string &key)
+                                 { return entry.name < key; });
+      if (it == entries_.end() || it->name != name)
+      {
+        return nullptr;
+      }
+      return &*it;
+    }
+
+    bool MediaIndex::is_media_file_(const char *name)
+    {
+      const char *ext = strrchr(name, '.');
+      if (ext == nullptr)
+      {
+        return false;
+      }
+      return strcasecmp(ext, ".jpg") == 0 || strcasecmp(ext, ".jpeg") == 0 || strcasecmp(ext, ".png") == 0 ||
+             strcasecmp(ext, ".bmp") == 0;
+    }
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
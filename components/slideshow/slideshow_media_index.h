@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SLIDESHOW_MEDIA_INDEX
+
+#include <dirent.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Compact on-card index of a media directory. Loading the index is one
+    // sequential read, so a playlist is available right after boot; the
+    // directory itself is revalidated in small background steps, comparing
+    // size and mtime per file instead of rebuilding the index.
+    class MediaIndex
+    {
+    public:
+      struct Entry
+      {
+        std::string name; // File name relative to the directory
+        uint32_t size{0};
+        uint32_t mtime{0};
+        uint16_t width{0}; // 0 until the image has been loaded once
+        uint16_t height{0};
+      };
+
+      void set_directory(const std::string &directory) { directory_ = directory; }
+      void set_index_file(const std::string &index_file) { index_file_ = index_file; }
+      const std::string &get_directory() const { return directory_; }
+      std::string get_index_file() const;
+
+      // Read the index from the card, or from the temporary file of an
+      // interrupted save. Returns false if missing or unreadable.
+      bool load();
+      bool save();
+
+      const std::vector<Entry> &entries() const { return entries_; }
+      std::string full_path(const Entry &entry) const { return directory_ + "/" + entry.name; }
+
+      // Remember dimensions learned when a file was loaded (saved with the next change)
+      void set_dimensions(const std::string &path, uint16_t width, uint16_t height);
+
+      // Incremental revalidation: begin, then step until it returns true
+      bool begin_revalidate();
+      bool revalidate_step(size_t max_files);
+      bool is_revalidating() const { return dir_ != nullptr; }
+
+      // Files found by the last completed revalidation that were not indexed before
+      const std::vector<std::string> &get_added() const { return added_; }
+      // Indexed files the last completed revalidation no longer found
+      const std::vector<std::string> &get_removed() const { return removed_; }
+
+    protected:
+      static bool is_media_file_(const char *name);
+      Entry *find_(const std::string &name);
+      bool load_file_(const std::string &path);
+      void finish_revalidate_();
+
+      std::string directory_;
+      std::string index_file_;
+      std::vector<Entry> entries_; // Sorted by name
+
+      // Revalidation state
+      DIR *dir_{nullptr};
+      std::vector<bool> seen_;
+      std::vector<Entry> found_;
+      std::vector<std::string> added_;
+      std::vector<std::string> removed_;
+      bool changed_{false};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
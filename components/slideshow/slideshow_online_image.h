@@ -1,67 +1,135 @@
 #pragma once
 
-#include "esphome/core/component.h"
+#include "esphome/core/log.h"
 #include "esphome/components/online_image/online_image.h"
 
-#include "slideshow.h"
+#include "slideshow_callbacks.h"
+#include "slideshow_frame.h"
+#include "slideshow_validators.h"
 
 namespace esphome
 {
   namespace slideshow
   {
-    class OnlineImageSlot : public SlideshowSlot
+    // online_image keeps the validators of its frame in protected members.
+    // Member pointers taken through a subclass reach them on the images
+    // codegen creates; this class is never instantiated.
+    struct OnlineImageValidators : online_image::OnlineImage
+    {
+      static std::string &etag(online_image::OnlineImage *img)
+      {
+        return img->*(&OnlineImageValidators::etag_);
+      }
+      static std::string &last_modified(online_image::OnlineImage *img)
+      {
+        return img->*(&OnlineImageValidators::last_modified_);
+      }
+    };
+
+    class OnlineImageSlot
     {
     public:
-      OnlineImageSlot(esphome::online_image::OnlineImage *img) : img_(img)
+      OnlineImageSlot(esphome::online_image::OnlineImage *img, OnceCallbackManager *callbacks) : img_(img), callbacks_(callbacks)
       {
         this->img_->add_on_finished_callback([this](bool cached)
                                              {
                                               ESP_LOGI("slideshow", "Image finished with cached: %s", cached ? "true" : "false");
-                                              this->callbacks_.call(true);
+                                              // Update state first so listeners see a ready slot
+                                              this->cached_ = cached;
                                               this->ready_ = true;
-                                              this->failed_ = false; });
+                                              this->failed_ = false;
+                                              this->callbacks_->call(true); });
         this->img_->add_on_error_callback([this]()
                                           {
-                                            this->callbacks_.call(false);
                                             this->ready_ = false;
-                                            this->failed_ = true; });
+                                            this->failed_ = true;
+                                            this->callbacks_->call(false); });
       }
 
-      void set_source(const std::string &source) override
+      // The callbacks above point at this adapter, so it must never be copied or moved
+      OnlineImageSlot(const OnlineImageSlot &) = delete;
+      OnlineImageSlot &operator=(const OnlineImageSlot &) = delete;
+
+      void set_source(const std::string &source)
       {
+        // A new source invalidates whatever the slot held before
+        this->ready_ = false;
+        this->failed_ = false;
+        this->cached_ = false;
+        // set_url() keeps the validators; they belong to the previous source
+        OnlineImageValidators::etag(this->img_).clear();
+        OnlineImageValidators::last_modified(this->img_).clear();
         this->img_->set_url(source);
       }
 
-      void update() override
+      void update()
+      {
+        this->img_->update();
+      }
+
+      // Keep the URL and send the pool's validators for it, so the request
+      // goes out as a conditional GET; a 304 keeps the decoded frame.
+      void revalidate(const HttpValidators &validators)
       {
+        this->cached_ = false;
+        OnlineImageValidators::etag(this->img_) = validators.etag;
+        OnlineImageValidators::last_modified(this->img_) = validators.last_modified;
         this->img_->update();
       }
 
-      void release() override
+      void release()
       {
+        this->ready_ = false;
         this->img_->release();
       }
 
-      esphome::image::Image *get_image() override
+      void set_displayed(bool displayed)
+      {
+        // online_image decodes into a buffer it owns and frees on release(),
+        // together with the validators, so there is no compact form to hold
+      }
+
+      size_t get_resident_bytes()
+      {
+        return this->ready_ ? image_frame_bytes(this->img_) : 0;
+      }
+
+      esphome::image::Image *get_image()
       {
         return this->img_;
       }
 
-      bool is_ready() override
+      bool is_ready()
       {
         return this->ready_;
       }
 
-      bool is_failed() override
+      bool is_failed()
       {
         return this->failed_;
       }
 
+      bool was_cached()
+      {
+        return this->cached_;
+      }
+
+      HttpValidators get_validators()
+      {
+        if (!this->ready_)
+        {
+          return {};
+        }
+        return {OnlineImageValidators::etag(this->img_), OnlineImageValidators::last_modified(this->img_)};
+      }
+
     protected:
       online_image::OnlineImage *img_;
+      OnceCallbackManager *callbacks_;
       bool ready_{false};
       bool failed_{false};
+      bool cached_{false};
     };
 
   } // namespace slideshow
-} // namespace esphome
\ No newline at end of file
+} // namespace esphome
@@ -0,0 +1,564 @@
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+
+#include "slideshow_pool.h"
+#include "slideshow.h"
+
+#include <algorithm>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+
+    static const char *const TAG = "slideshow.pool";
+
+    void SlideshowPool::reserve(size_t capacity)
+    {
+      if (size_ > 0)
+      {
+        ESP_LOGE(TAG, "Slots must be reserved before any are added");
+        return;
+      }
+
+      slots_.reset(new SlideshowSlot[capacity]);
+      capacity_ = capacity;
+      states_.reserve(capacity);
+    }
+
+    SlideshowSlot *SlideshowPool::add_slot()
+    {
+      if (size_ >= capacity_)
+      {
+        ESP_LOGE(TAG, "Slot pool is full (%d slots)", capacity_);
+        return nullptr;
+      }
+
+      states_.emplace_back();
+      return &slots_[size_++];
+    }
+
+    SlideshowSlot *SlideshowPool::get_slot(size_t slot_index)
+    {
+      if (slot_index < size_)
+      {
+        return &slots_[slot_index];
+      }
+      return nullptr;
+    }
+
+    void SlideshowPool::register_owner(SlideshowComponent *owner)
+    {
+      if (owner_index_(owner) != SIZE_MAX)
+        return;
+
+      owners_.push_back(owner);
+      pending_.emplace_back();
+      displayed_.push_back(SIZE_MAX);
+    }
+
+    size_t SlideshowPool::acquire(SlideshowComponent *owner, const std::string &source, uint32_t size_hint,
+                                 uint32_t trace_key)
+    {
+      // Shared hit: another reference already holds or is loading this source,
+      // a display still has the frame pinned, or a released load is still running
+      for (size_t i = 0; i < states_.size(); i++)
+      {
+        auto &state = states_[i];
+        if ((!state.refs.empty() || state.pins > 0 || state.draining) && state.source == source)
+        {
+          state.draining = false;
+          ESP_LOGD(TAG, "Sharing slot %d for '%s' (%d refs)", i, source.c_str(), state.refs.size() + 1);
+          state.refs.push_back(owner);
+          state.last_used = millis();
+          return i;
+        }
+      }
+
+      size_t slot_index = find_free_slot_(source);
+      if (slot_index == SIZE_MAX)
+      {
+        return SIZE_MAX;
+      }
+
+      auto &state = states_[slot_index];
+      auto *slot = &slots_[slot_index];
+
+      state.refs.push_back(owner);
+      state.last_used = millis();
+
+      if (revalidate_ && state.source == source && slot->is_ready() && !state.loading)
+      {
+        ESP_LOGD(TAG, "Revalidating held frame in slot %d", slot_index);
+        state.revalidate = true;
+      }
+      else
+      {
+        if (!state.source.empty())
+        {
+          evict_(slot_index);
+        }
+        state.source = source;
+        state.revalidate = false;
+      }
+#ifdef USE_SLIDESHOW_VARIANTS
+      state.size_hint = size_hint;
+#endif
+      if (trace_ != nullptr)
+      {
+        state.trace_key = trace_key != 0 ? trace_key : fnv1_hash(source);
+      }
+
+      // A slot dropped mid-load may still have a completion on the way
+      state.generation++;
+      state.loading = false;
+
+      if (!state.pending)
+      {
+        state.pending = true;
+        size_t owner_idx = owner_index_(owner);
+        pending_[owner_idx == SIZE_MAX ? 0 : owner_idx].push_back(slot_index);
+      }
+
+      return slot_index;
+    }
+
+    void SlideshowPool::prioritize(SlideshowComponent *owner, size_t slot_index)
+    {
+      if (slot_index >= states_.size() || !states_[slot_index].pending)
+      {
+        return;
+      }
+
+      size_t owner_idx = owner_index_(owner);
+      auto &queue = pending_[owner_idx == SIZE_MAX ? 0 : owner_idx];
+      auto it = std::find(queue.begin(), queue.end(), slot_index);
+      if (it != queue.end())
+      {
+        queue.erase(it);
+      }
+      queue.push_front(slot_index);
+    }
+
+    void SlideshowPool::release(SlideshowComponent *owner, size_t slot_index)
+    {
+      if (slot_index >= states_.size())
+      {
+        return;
+      }
+
+      auto &state = states_[slot_index];
+      auto it = std::find(state.refs.begin(), state.refs.end(), owner);
+      if (it == state.refs.end())
+      {
+        return;
+      }
+      state.refs.erase(it);
+
+      if (!state.refs.empty())
+      {
+        return;
+      }
+
+      // Nobody needs it any more. A load in flight cannot be stopped (e.g.
+      // online_image keeps downloading), so the slot is only reused after it
+      // completes; update() would be refused until then.
+      state.pending = false;
+      if (state.loading)
+      {
+        state.draining = true;
+        return;
+      }
+      state.generation++;
+
+      // A pinned frame is still on screen; it goes once the last pin does
+      if (state.pins == 0)
+      {
+        drop_unreferenced_(slot_index);
+      }
+    }
+
+    void SlideshowPool::drop_unreferenced_(size_t slot_index)
+    {
+      if (revalidate_ && slots_[slot_index].is_ready())
+      {
+        // Keep the frame (and its validators) around in case the source comes back
+        ESP_LOGD(TAG, "Holding frame in slot %d for revalidation", slot_index);
+        return;
+      }
+
+      evict_(slot_index);
+    }
+
+    void SlideshowPool::set_displayed(SlideshowComponent *owner, size_t slot_index)
+    {
+      size_t owner_idx = owner_index_(owner);
+      if (owner_idx == SIZE_MAX || displayed_[owner_idx] == slot_index)
+      {
+        return;
+      }
+
+      size_t previous = displayed_[owner_idx];
+      displayed_[owner_idx] = slot_index;
+
+      if (previous != SIZE_MAX && !is_displayed(previous))
+      {
+        slots_[previous].set_displayed(false);
+      }
+      if (slot_index != SIZE_MAX)
+      {
+        slots_[slot_index].set_displayed(true);
+      }
+    }
+
+    bool SlideshowPool::is_displayed(size_t slot_index) const
+    {
+      if (slot_index < states_.size() && states_[slot_index].pins > 0)
+      {
+        return true;
+      }
+      return std::find(displayed_.begin(), displayed_.end(), slot_index) != displayed_.end();
+    }
+
+    void SlideshowPool::pin(size_t slot_index)
+    {
+      if (slot_index >= states_.size())
+      {
+        return;
+      }
+
+      // Expand compactly held frames, so the pixels stay put while pinned
+      if (states_[slot_index].pins++ == 0)
+      {
+        slots_[slot_index].set_displayed(true);
+      }
+    }
+
+    void SlideshowPool::unpin(size_t slot_index)
+    {
+      if (slot_index >= states_.size() || states_[slot_index].pins == 0)
+      {
+        return;
+      }
+
+      auto &state = states_[slot_index];
+      if (--state.pins > 0)
+      {
+        return;
+      }
+      if (!is_displayed(slot_index))
+      {
+        slots_[slot_index].set_displayed(false);
+      }
+      if (state.refs.empty() && !state.source.empty())
+      {
+        drop_unreferenced_(slot_index);
+      }
+    }
+
+    void SlideshowPool::evict_unused()
+    {
+      for (size_t i = 0; i < states_.size(); i++)
+      {
+        if (states_[i].refs.empty() && states_[i].pins == 0 && !states_[i].draining && !states_[i].source.empty())
+        {
+          evict_(i);
+        }
+      }
+    }
+
+    bool SlideshowPool::process_loads(const TimeBudget *budget)
+    {
+      // Embedded slots complete synchronously, which re-enters here
+      if (processing_ || owners_.empty())
+        return false;
+      processing_ = true;
+
+      size_t idle_owners = 0;
+      while (idle_owners < owners_.size() &&
+             (max_concurrent_loads_ == 0 || active_loads_ < max_concurrent_loads_))
+      {
+        // Starting a load can block (e.g. an HTTP connect); leave the rest for the next iteration
+        if (budget != nullptr && budget->expired())
+        {
+          processing_ = false;
+          return true;
+        }
+
+        size_t owner_idx = next_owner_ % owners_.size();
+        next_owner_ = owner_idx + 1;
+
+        auto &queue = pending_[owner_idx];
+        // Skip entries that were released or re-queued since
+        while (!queue.empty() && !states_[queue.front()].pending)
+        {
+          queue.pop_front();
+        }
+
+        if (queue.empty())
+        {
+          idle_owners++;
+          continue;
+        }
+        idle_owners = 0;
+
+        size_t slot_index = queue.front();
+        queue.pop_front();
+        start_load_(slot_index);
+      }
+
+      processing_ = false;
+      return false;
+    }
+
+    bool SlideshowPool::is_loading(size_t slot_index) const
+    {
+      return slot_index < states_.size() && states_[slot_index].loading;
+    }
+
+    bool SlideshowPool::is_pending(size_t slot_index) const
+    {
+      return slot_index < states_.size() && states_[slot_index].pending;
+    }
+
+    bool SlideshowPool::is_pinned(size_t slot_index) const
+    {
+      return slot_index < states_.size() && states_[slot_index].pins > 0;
+    }
+
+    const std::string &SlideshowPool::get_source(size_t slot_index) const
+    {
+      return states_[slot_index].source;
+    }
+
+    size_t SlideshowPool::get_resident_bytes(size_t slot_index)
+    {
+      return slots_[slot_index].get_resident_bytes();
+    }
+
+    const HttpValidators *SlideshowPool::get_validators(const std::string &source) const
+    {
+      auto it = validators_.find(source);
+      return it != validators_.end() ? &it->second : nullptr;
+    }
+
+    size_t SlideshowPool::find_free_slot_(const std::string &source)
+    {
+      size_t best = SIZE_MAX;
+
+      for (size_t i = 0; i < states_.size(); i++)
+      {
+        const auto &state = states_[i];
+        if (!state.refs.empty() || state.pins > 0 || state.draining)
+        {
+          continue;
+        }
+
+        // A slot still holding this source can be revalidated instead of refetched
+        if (revalidate_ && state.source == source)
+        {
+          return i;
+        }
+
+        // Otherwise prefer empty slots, then the least recently used held frame
+        if (state.source.empty())
+        {
+          if (best == SIZE_MAX || !states_[best].source.empty())
+          {
+            best = i;
+          }
+        }
+        else if (best == SIZE_MAX ||
+                 (!states_[best].source.empty() && state.last_used < states_[best].last_used))
+        {
+          best = i;
+        }
+      }
+
+      return best;
+    }
+
+#ifdef USE_SLIDESHOW_VARIANTS
+    uint32_t SlideshowPool::estimate_throughput()
+    {
+      size_t slot_index = find_free_slot_("");
+      if (slot_index == SIZE_MAX)
+      {
+        slot_index = 0;
+      }
+      return throughput_.get(slot_index < size_ ? slots_[slot_index].type_index() : 0);
+    }
+#endif
+
+    size_t SlideshowPool::owner_index_(SlideshowComponent *owner) const
+    {
+      for (size_t i = 0; i < owners_.size(); i++)
+      {
+        if (owners_[i] == owner)
+        {
+          return i;
+        }
+      }
+      return SIZE_MAX;
+    }
+
+    void SlideshowPool::evict_(size_t slot_index)
+    {
+      auto *slot = &slots_[slot_index];
+      if (is_displayed(slot_index))
+      {
+        slot->set_displayed(false);
+        std::replace(displayed_.begin(), displayed_.end(), slot_index, SIZE_MAX);
+      }
+      if (slot->is_ready())
+      {
+        ESP_LOGD(TAG, "Calling release() on slot %d", slot_index);
+        slot->release();
+      }
+
+      validators_.erase(states_[slot_index].source);
+      states_[slot_index].source.clear();
+      states_[slot_index].last_used = 0;
+    }
+
+    void SlideshowPool::start_load_(size_t slot_index)
+    {
+      auto &state = states_[slot_index];
+      auto *slot = &slots_[slot_index];
+
+      state.pending = false;
+      state.loading = true;
+      active_loads_++;
+#ifdef USE_SLIDESHOW_VARIANTS
+      state.load_started = millis();
+#endif
+
+      ESP_LOGI(TAG, "Loading source '%s' into slot %d", state.source.c_str(), slot_index);
+      if (trace_ != nullptr)
+      {
+        trace_->record(millis(), TRACE_LOAD_START, slot_index, state.revalidate ? TRACE_FLAG_REVALIDATE : 0,
+                       state.trace_key);
+      }
+
+      // Register before starting, some slots complete synchronously
+      uint32_t generation = state.generation;
+      slot->callback_once([this, slot_index, generation](bool success)
+                          { this->on_load_complete_(slot_index, generation, success); });
+
+      if (state.revalidate)
+      {
+        revalidations_++;
+        auto it = validators_.find(state.source);
+        slot->revalidate(it != validators_.end() ? it->second : HttpValidators{});
+      }
+      else
+      {
+        slot->set_source(state.source);
+        slot->update();
+      }
+    }
+
+    void SlideshowPool::on_load_complete_(size_t slot_index, uint32_t generation, bool success)
+    {
+      auto &state = states_[slot_index];
+
+      // Check the load is still wanted before processing the callback
+      if (!state.loading || state.generation != generation)
+      {
+        ESP_LOGD(TAG, "Ignoring callback for released slot %d", slot_index);
+        return;
+      }
+
+      state.loading = false;
+      active_loads_--;
+      bool drained = state.draining;
+      state.draining = false;
+
+#ifdef USE_SLIDESHOW_VARIANTS
+      // Only full downloads of a known size say anything about the link
+      if (success && !state.revalidate && state.size_hint > 0 && !slots_[slot_index].was_cached())
+      {
+        size_t type = slots_[slot_index].type_index();
+        throughput_.record(type, state.size_hint, millis() - state.load_started);
+        ESP_LOGD(TAG, "Loaded %u bytes in %ums, slot type %d now estimated at %u B/s", state.size_hint,
+                 millis() - state.load_started, type, throughput_.get(type));
+      }
+#endif
+      if (success && state.revalidate && slots_[slot_index].was_cached())
+      {
+        revalidation_hits_++;
+        ESP_LOGD(TAG, "Source not modified, reused held frame (%u/%u revalidations hit)",
+                 revalidation_hits_, revalidations_);
+      }
+      state.revalidate = false;
+
+      if (revalidate_ && success)
+      {
+        HttpValidators validators = slots_[slot_index].get_validators();
+        if (validators.empty())
+        {
+          validators_.erase(state.source);
+        }
+        else
+        {
+          validators_[state.source] = std::move(validators);
+        }
+      }
+
+      if (trace_ != nullptr)
+      {
+        if (success)
+        {
+          // What the slot holds, compact or not: a compressed frame is not
+          // expanded until displayed, so its decoded size would read 0 here
+          auto *slot = &slots_[slot_index];
+          trace_->record(millis(), TRACE_READY, slot_index, slot->was_cached() ? TRACE_FLAG_CACHED : 0,
+                         slot->get_resident_bytes());
+        }
+        else
+        {
+          trace_->record(millis(), TRACE_ERROR, slot_index, 0, 0);
+        }
+      }
+
+      if (!success)
+      {
+        // Whatever the slot held is no longer usable
+        validators_.erase(state.source);
+        state.source.clear();
+      }
+      else if (drained && state.pins == 0)
+      {
+        drop_unreferenced_(slot_index);
+      }
+
+      // Notify each holder once; copy since handlers may release references
+      std::vector<SlideshowComponent *> owners = state.refs;
+      std::sort(owners.begin(), owners.end());
+      owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+      for (auto *owner : owners)
+      {
+        if (success)
+        {
+          owner->on_image_ready(slot_index);
+        }
+        else
+        {
+          owner->on_image_error(slot_index);
+        }
+      }
+
+      // The next load starts from a slideshow loop, within its time budget.
+      // A slot released while loading is free again for items that found none.
+      for (auto *owner : owners_)
+      {
+        owner->schedule_loads();
+        if (drained)
+        {
+          owner->on_slot_freed();
+        }
+      }
+    }
+
+  } // namespace slideshow
+} // namespace esphome
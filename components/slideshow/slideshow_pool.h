@@ -0,0 +1,148 @@
+#pragma once
+
+#include "slideshow_budget.h"
+#include "slideshow_slot.h"
+#include "slideshow_trace.h"
+#include "slideshow_variants.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    class SlideshowComponent;
+
+    // Image slots shared by one or more slideshows. Frames are keyed by source,
+    // so an image wanted by several slideshows is loaded once and reference counted.
+    class SlideshowPool
+    {
+    public:
+      // Slots live in one contiguous array sized up front, and never move
+      void reserve(size_t capacity);
+      SlideshowSlot *add_slot();
+      size_t size() const { return size_; }
+      SlideshowSlot *get_slot(size_t slot_index);
+
+      void set_revalidate(bool revalidate) { revalidate_ = revalidate; }
+      bool get_revalidate() const { return revalidate_; }
+      void set_max_concurrent_loads(size_t max) { max_concurrent_loads_ = max; }
+      size_t get_max_concurrent_loads() const { return max_concurrent_loads_; }
+
+      // Record load events (owned by the slideshow that owns the pool)
+      void set_trace(TraceRecorder *trace) { trace_ = trace; }
+
+      // Every slideshow drawing from the pool registers once, in setup()
+      void register_owner(SlideshowComponent *owner);
+      size_t owner_count() const { return owners_.size(); }
+
+      // Take a reference on a slot holding `source`, queueing a load if it isn't
+      // already held or loading. Returns SIZE_MAX when every slot is referenced.
+      // size_hint is the expected download size, when known, for throughput estimates.
+      // trace_key is the hash load events are traced under, 0 for that of `source`.
+      size_t acquire(SlideshowComponent *owner, const std::string &source, uint32_t size_hint = 0,
+                     uint32_t trace_key = 0);
+
+      // Start this slot's queued load before the owner's other queued loads
+      void prioritize(SlideshowComponent *owner, size_t slot_index);
+
+      // Drop a reference. Unreferenced frames are released, or held for
+      // revalidation when enabled. A slot released mid-load stays busy until
+      // that load completes, since the image cannot start another one before.
+      void release(SlideshowComponent *owner, size_t slot_index);
+
+      // Mark the slot an owner currently shows (SIZE_MAX for none). A slot
+      // stays displayed while any owner shows it.
+      void set_displayed(SlideshowComponent *owner, size_t slot_index);
+      bool is_displayed(size_t slot_index) const;
+
+      // Keep a loaded frame in place while a display reads it: a pinned slot
+      // counts as displayed and is not released, reloaded or reused until
+      // every pin is dropped.
+      void pin(size_t slot_index);
+      void unpin(size_t slot_index);
+
+      // Release held frames nobody references
+      void evict_unused();
+
+      // Start queued loads, taking turns between owners, while the budget
+      // lasts; returns true if it stopped early with loads left to start.
+      bool process_loads(const TimeBudget *budget = nullptr);
+
+      bool is_loading(size_t slot_index) const;
+      bool is_pending(size_t slot_index) const;
+      bool is_pinned(size_t slot_index) const;
+      const std::string &get_source(size_t slot_index) const;
+      size_t get_resident_bytes(size_t slot_index);
+
+      // Validators of the held frame of `source`, nullptr if none is kept
+      const HttpValidators *get_validators(const std::string &source) const;
+
+      uint32_t get_revalidations() const { return revalidations_; }
+      uint32_t get_revalidation_hits() const { return revalidation_hits_; }
+#ifdef USE_SLIDESHOW_VARIANTS
+      ThroughputEstimator *get_throughput() { return &throughput_; }
+      // Estimated bytes per second for the kind of slot the next load would use
+      uint32_t estimate_throughput();
+#endif
+
+    protected:
+      struct SlotState
+      {
+        std::string source;                     // Source the slot holds (or is loading)
+        std::vector<SlideshowComponent *> refs; // One entry per reference
+        bool pending{false};                    // Waiting for a load turn
+        bool loading{false};                    // Load in flight
+        bool revalidate{false};                 // Pending load is a revalidation
+        bool draining{false};                   // Unreferenced, waiting for its load to complete
+        uint32_t generation{0};                 // Bumped per load to drop stale completions
+        uint32_t last_used{0};
+        uint8_t pins{0};
+        uint32_t trace_key{0}; // Source hash recorded with load events
+#ifdef USE_SLIDESHOW_VARIANTS
+        uint32_t size_hint{0};    // Expected bytes of the source, 0 if unknown
+        uint32_t load_started{0}; // millis() when the load started
+#endif
+      };
+
+      size_t find_free_slot_(const std::string &source);
+      size_t owner_index_(SlideshowComponent *owner) const;
+      void evict_(size_t slot_index);
+      void drop_unreferenced_(size_t slot_index);
+      void start_load_(size_t slot_index);
+      void on_load_complete_(size_t slot_index, uint32_t generation, bool success);
+
+      std::unique_ptr<SlideshowSlot[]> slots_;
+      size_t capacity_{0};
+      size_t size_{0};
+      std::vector<SlotState> states_;
+
+      // Registered owners and their queued loads (round-robin between them)
+      std::vector<SlideshowComponent *> owners_;
+      std::vector<std::deque<size_t>> pending_;
+      std::vector<size_t> displayed_; // Slot shown by each owner
+      size_t next_owner_{0};
+
+      bool revalidate_{false};
+      size_t max_concurrent_loads_{0}; // 0 = unlimited
+      size_t active_loads_{0};
+      bool processing_{false};
+
+      // Keyed by source rather than slot, and kept only while a slot holds
+      // that source's frame, since a 304 is only useful with the frame
+      std::map<std::string, HttpValidators> validators_;
+      uint32_t revalidations_{0};
+      uint32_t revalidation_hits_{0};
+#ifdef USE_SLIDESHOW_VARIANTS
+      ThroughputEstimator throughput_;
+#endif
+
+      TraceRecorder *trace_{nullptr};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -0,0 +1,203 @@
+#include "slideshow_preview.h"
+
+#ifdef USE_SLIDESHOW_PREVIEW
+
+#include <cmath>
+#include <cstring>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    static const char BASE83_CHARS[] =
+        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@[]^_{|}~";
+
+    // Linear light (Q12 >> 2) to 8 bit sRGB, built on first use
+    static const int LINEAR_LUT_SIZE = 1024;
+    static uint8_t linear_to_srgb_lut[LINEAR_LUT_SIZE];
+    static bool linear_to_srgb_built = false;
+
+    static int decode83(const std::string &str, size_t start, size_t length)
+    {
+      int value = 0;
+      for (size_t i = start; i < start + length; i++)
+      {
+        const char *pos = strchr(BASE83_CHARS, str[i]);
+        if (str[i] == '\0' || pos == nullptr)
+        {
+          return -1;
+        }
+        value = value * 83 + static_cast<int>(pos - BASE83_CHARS);
+      }
+      return value;
+    }
+
+    static int32_t srgb_to_linear_q12(int value)
+    {
+      float v = value / 255.0f;
+      float linear = v <= 0.04045f ? v / 12.92f : powf((v + 0.055f) / 1.055f, 2.4f);
+      return static_cast<int32_t>(linear * 4096.0f + 0.5f);
+    }
+
+    static void build_linear_to_srgb()
+    {
+      for (int i = 0; i < LINEAR_LUT_SIZE; i++)
+      {
+        float v = (i + 0.5f) / LINEAR_LUT_SIZE;
+        float srgb = v <= 0.0031308f ? v * 12.92f : 1.055f * powf(v, 1.0f / 2.4f) - 0.055f;
+        int value = static_cast<int>(srgb * 255.0f + 0.5f);
+        linear_to_srgb_lut[i] = value > 255 ? 255 : value;
+      }
+      linear_to_srgb_built = true;
+    }
+
+    static inline uint8_t linear_to_srgb(int32_t q12)
+    {
+      if (q12 <= 0)
+        return linear_to_srgb_lut[0];
+      if (q12 >= 4096)
+        return 255;
+      return linear_to_srgb_lut[q12 >> 2];
+    }
+
+    bool BlurHashDecoder::is_valid(const std::string &hash)
+    {
+      if (hash.size() < 6)
+      {
+        return false;
+      }
+      int size_flag = decode83(hash, 0, 1);
+      if (size_flag < 0)
+      {
+        return false;
+      }
+      size_t components = (size_flag / 9 + 1) * (size_flag % 9 + 1);
+      if (hash.size() != 4 + 2 * components)
+      {
+        return false;
+      }
+      for (char c : hash)
+      {
+        if (c == '\0' || strchr(BASE83_CHARS, c) == nullptr)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    bool BlurHashDecoder::begin(const std::string &hash, FrameBuffer *out)
+    {
+      out_ = nullptr;
+      if (!is_valid(hash) || out == nullptr || !out->is_allocated())
+      {
+        return false;
+      }
+      if (!linear_to_srgb_built)
+      {
+        build_linear_to_srgb();
+      }
+
+      int size_flag = decode83(hash, 0, 1);
+      components_y_ = size_flag / 9 + 1;
+      components_x_ = size_flag % 9 + 1;
+      float max_ac = (decode83(hash, 1, 1) + 1) / 166.0f;
+
+      int dc = decode83(hash, 2, 4);
+      colors_[0][0] = srgb_to_linear_q12(dc >> 16);
+      colors_[0][1] = srgb_to_linear_q12((dc >> 8) & 0xFF);
+      colors_[0][2] = srgb_to_linear_q12(dc & 0xFF);
+
+      int count = components_x_ * components_y_;
+      for (int i = 1; i < count; i++)
+      {
+        int ac = decode83(hash, 4 + i * 2, 2);
+        int quantized[3] = {ac / (19 * 19), (ac / 19) % 19, ac % 19};
+        for (int c = 0; c < 3; c++)
+        {
+          // signPow((q - 9) / 9, 2) * maxAC
+          float v = (quantized[c] - 9) / 9.0f;
+          colors_[i][c] = static_cast<int32_t>(copysignf(v * v, v) * max_ac * 4096.0f);
+        }
+      }
+
+      int width = out->get_image()->get_width();
+      cos_x_.resize(width * components_x_);
+      for (int x = 0; x < width; x++)
+      {
+        for (int i = 0; i < components_x_; i++)
+        {
+          cos_x_[x * components_x_ + i] = static_cast<int16_t>(cosf(M_PI * x * i / width) * 16384.0f);
+        }
+      }
+
+      out_ = out;
+      row_ = 0;
+      return true;
+    }
+
+    bool BlurHashDecoder::decode_rows(int max_rows)
+    {
+      if (out_ == nullptr)
+      {
+        return true;
+      }
+
+      int width = out_->get_image()->get_width();
+      int height = out_->get_image()->get_height();
+      int end = row_ + max_rows < height ? row_ + max_rows : height;
+
+      for (; row_ < end; row_++)
+      {
+        // Fold the y components into one color per x component for this row
+        int32_t row_colors[MAX_COMPONENTS][3];
+        int32_t cos_y[MAX_COMPONENTS];
+        for (int j = 0; j < components_y_; j++)
+        {
+          cos_y[j] = static_cast<int32_t>(cosf(M_PI * row_ * j / height) * 16384.0f);
+        }
+        for (int i = 0; i < components_x_; i++)
+        {
+          for (int c = 0; c < 3; c++)
+          {
+            int32_t sum = 0;
+            for (int j = 0; j < components_y_; j++)
+            {
+              sum += cos_y[j] * colors_[j * components_x_ + i][c];
+            }
+            // Q10, so nine Q14 cosine products still fit 32 bits in the horizontal pass
+            row_colors[i][c] = sum >> 16;
+          }
+        }
+
+        // RGB565, big endian like image::Image expects
+        uint8_t *dst = out_->data() + static_cast<size_t>(row_) * width * 2;
+        const int16_t *cos_x = cos_x_.data();
+        for (int x = 0; x < width; x++, cos_x += components_x_)
+        {
+          int32_t r = 0, g = 0, b = 0;
+          for (int i = 0; i < components_x_; i++)
+          {
+            r += cos_x[i] * row_colors[i][0];
+            g += cos_x[i] * row_colors[i][1];
+            b += cos_x[i] * row_colors[i][2];
+          }
+          uint16_t pixel = ((linear_to_srgb(r >> 12) & 0xF8) << 8) | ((linear_to_srgb(g >> 12) & 0xFC) << 3) |
+                           (linear_to_srgb(b >> 12) >> 3);
+          *dst++ = pixel >> 8;
+          *dst++ = pixel & 0xFF;
+        }
+      }
+
+      if (row_ < height)
+      {
+        return false;
+      }
+      out_ = nullptr;
+      return true;
+    }
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SLIDESHOW_PREVIEW
+
+#include "slideshow_frame.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Renders a BlurHash (https://blurha.sh) into an RGB565 frame with
+    // fixed-point math. Decoding is split into rows so a full panel-sized
+    // preview can be spread over loop iterations.
+    class BlurHashDecoder
+    {
+    public:
+      static bool is_valid(const std::string &hash);
+
+      // Parse the hash and start rendering into out (RGB565, already allocated)
+      bool begin(const std::string &hash, FrameBuffer *out);
+      // Render up to max_rows rows; returns true once the frame is complete
+      bool decode_rows(int max_rows);
+      void abort() { out_ = nullptr; }
+      bool is_decoding() const { return out_ != nullptr; }
+
+    protected:
+      static const int MAX_COMPONENTS = 9;
+
+      int components_x_{0};
+      int components_y_{0};
+      // Linear RGB per component, Q12
+      int32_t colors_[MAX_COMPONENTS * MAX_COMPONENTS][3];
+      // cos(pi * x * i / width) per column and x component, Q14
+      std::vector<int16_t> cos_x_;
+
+      FrameBuffer *out_{nullptr};
+      int row_{0};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,429 @@
+#include "slideshow_raw_frame.h"
+
+#ifdef USE_SLIDESHOW_RAW_SLOT
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include "slideshow_frame.h"
+
+#include <algorithm>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+
+    static const char *const TAG = "slideshow.raw_frame";
+
+    static const uint32_t RAW_FRAME_MAGIC = 0x46525353; // "SSRF"
+    static const uint8_t RAW_FRAME_VERSION = 1;
+
+    // Bytes per read; the time budget is checked between reads
+    static const size_t RAW_FRAME_CHUNK_SIZE = 4096;
+    static const uint32_t RAW_FRAME_STALL_TIMEOUT_MS = 15000;
+
+    void RawFrameImage::dump_config()
+    {
+      ESP_LOGCONFIG(TAG, "Raw frame image:");
+      ESP_LOGCONFIG(TAG, "  Type: %d", this->type_);
+      ESP_LOGCONFIG(TAG, "  HTTP: %s", YESNO(this->http_ != nullptr));
+      ESP_LOGCONFIG(TAG, "  Compressed residency: %s", YESNO(this->compressed_residency_));
+      ESP_LOGCONFIG(TAG, "  Time budget: %uus", this->time_budget_us_);
+    }
+
+    void RawFrameImage::update()
+    {
+      // Restarting abandons any load in flight; the buffer is reused if the size matches
+      this->close_();
+      this->width_ = 0;
+      this->height_ = 0;
+      this->data_start_ = nullptr;
+      this->compressed_size_ = 0;
+
+      this->state_ = STATE_HEADER;
+      this->header_pos_ = 0;
+      this->load_start_ = millis();
+      this->last_progress_ = this->load_start_;
+
+      if (this->open_())
+      {
+        this->enable_loop();
+      }
+    }
+
+    void RawFrameImage::release()
+    {
+      this->close_();
+      this->state_ = STATE_IDLE;
+      this->width_ = 0;
+      this->height_ = 0;
+      this->data_start_ = nullptr;
+      this->displayed_ = false;
+      this->free_buffer_();
+      this->free_compressed_();
+    }
+
+    void RawFrameImage::set_displayed(bool displayed)
+    {
+      this->displayed_ = displayed;
+      if (this->compressed_size_ == 0)
+      {
+        return; // Nothing held compressed (or still loading)
+      }
+
+      if (displayed && this->data_start_ == nullptr)
+      {
+        if (!this->expand_())
+        {
+          this->free_compressed_();
+          this->fail_("corrupt LZ4 payload");
+        }
+      }
+      else if (!displayed && this->data_start_ != nullptr)
+      {
+        this->collapse_();
+      }
+    }
+
+    void RawFrameImage::loop()
+    {
+      if (this->state_ == STATE_IDLE)
+      {
+        this->disable_loop();
+        return;
+      }
+
+      // Stream in bounded slices so one large frame does not stall the main loop
+      TimeBudget budget(this->time_budget_us_);
+      do
+      {
+        bool progressed = this->state_ == STATE_HEADER ? this->read_header_() : this->read_payload_();
+        if (this->state_ == STATE_IDLE)
+        {
+          return; // Finished or failed
+        }
+        if (!progressed)
+        {
+          break;
+        }
+        this->last_progress_ = millis();
+      } while (!budget.expired());
+
+      if (millis() - this->last_progress_ > RAW_FRAME_STALL_TIMEOUT_MS)
+      {
+        this->fail_("transfer stalled");
+      }
+    }
+
+    bool RawFrameImage::open_()
+    {
+      if (this->source_.rfind("http://", 0) == 0 || this->source_.rfind("https://", 0) == 0)
+      {
+        if (this->http_ == nullptr)
+        {
+          this->fail_("no http_request configured");
+          return false;
+        }
+
+        this->container_ = this->http_->get(this->source_);
+        if (this->container_ == nullptr || this->container_->status_code != 200)
+        {
+          ESP_LOGE(TAG, "HTTP request for %s returned %d", this->source_.c_str(),
+                   this->container_ == nullptr ? -1 : this->container_->status_code);
+          this->fail_("request failed");
+          return false;
+        }
+        return true;
+      }
+
+      this->file_ = fopen(this->source_.c_str(), "rb");
+      if (this->file_ == nullptr)
+      {
+        this->fail_("cannot open file");
+        return false;
+      }
+      return true;
+    }
+
+    void RawFrameImage::close_()
+    {
+      if (this->container_ != nullptr)
+      {
+        this->container_->end();
+        this->container_.reset();
+      }
+      if (this->file_ != nullptr)
+      {
+        fclose(this->file_);
+        this->file_ = nullptr;
+      }
+    }
+
+    int RawFrameImage::read_(uint8_t *buf, size_t len)
+    {
+      if (this->container_ != nullptr)
+      {
+        // 0 means no data yet; the next loop() tries again
+        return this->container_->read(buf, len);
+      }
+
+      // Files never block, so a short read is the end of the file
+      size_t count = fread(buf, 1, len, this->file_);
+      return count == 0 ? -1 : static_cast<int>(count);
+    }
+
+    bool RawFrameImage::read_header_()
+    {
+      auto *dst = reinterpret_cast<uint8_t *>(&this->header_) + this->header_pos_;
+      int count = this->read_(dst, sizeof(this->header_) - this->header_pos_);
+      if (count < 0)
+      {
+        this->fail_("truncated header");
+        return false;
+      }
+      if (count == 0)
+      {
+        return false;
+      }
+
+      this->header_pos_ += count;
+      if (this->header_pos_ < sizeof(this->header_))
+      {
+        return true;
+      }
+      return this->begin_payload_();
+    }
+
+    bool RawFrameImage::begin_payload_()
+    {
+      const auto &header = this->header_;
+      if (header.magic != RAW_FRAME_MAGIC || header.version != RAW_FRAME_VERSION)
+      {
+        this->fail_("not a raw frame");
+        return false;
+      }
+      if (header.type != this->type_)
+      {
+        ESP_LOGE(TAG, "Frame type %u does not match the slot type %d", header.type, this->type_);
+        this->fail_("wrong pixel type");
+        return false;
+      }
+
+      size_t size = frame_bytes(header.width, header.height, this->type_);
+      bool valid;
+      switch (header.compression)
+      {
+      case RAW_FRAME_COMPRESSION_NONE:
+        valid = size > 0 && header.payload_size == size;
+        break;
+      case RAW_FRAME_COMPRESSION_LZ4:
+        valid = size > 0 && header.payload_size > 0;
+        break;
+      default:
+        valid = false;
+      }
+      if (!valid)
+      {
+        this->fail_("invalid header");
+        return false;
+      }
+
+      if (header.compression == RAW_FRAME_COMPRESSION_LZ4 && this->compressed_residency_)
+      {
+        // Keep the payload as received; it is expanded when displayed
+        this->free_buffer_();
+        if (this->compressed_capacity_ < header.payload_size)
+        {
+          this->free_compressed_();
+          this->compressed_ = this->allocator_.allocate(header.payload_size);
+          if (this->compressed_ == nullptr)
+          {
+            this->fail_("out of memory");
+            return false;
+          }
+          this->compressed_capacity_ = header.payload_size;
+        }
+        this->payload_pos_ = 0;
+        this->state_ = STATE_PAYLOAD;
+        return true;
+      }
+
+      this->free_compressed_();
+      if (!this->allocate_buffer_(size))
+      {
+        this->fail_("out of memory");
+        return false;
+      }
+
+      if (header.compression == RAW_FRAME_COMPRESSION_LZ4)
+      {
+        if (!this->chunk_)
+        {
+          this->chunk_.reset(new uint8_t[RAW_FRAME_CHUNK_SIZE]);
+        }
+        this->lz4_.reset(this->buffer_, size);
+      }
+
+      this->payload_pos_ = 0;
+      this->state_ = STATE_PAYLOAD;
+      return true;
+    }
+
+    bool RawFrameImage::read_payload_()
+    {
+      size_t remaining = this->header_.payload_size - this->payload_pos_;
+      size_t len = std::min(remaining, RAW_FRAME_CHUNK_SIZE);
+      bool keep_compressed = this->compressed_ != nullptr;
+      bool lz4 = this->header_.compression == RAW_FRAME_COMPRESSION_LZ4 && !keep_compressed;
+
+      // Uncompressed pixels land directly in the frame buffer, held payloads in theirs
+      uint8_t *dst = lz4 ? this->chunk_.get()
+                         : (keep_compressed ? this->compressed_ : this->buffer_) + this->payload_pos_;
+      int count = this->read_(dst, len);
+      if (count < 0)
+      {
+        this->fail_("truncated payload");
+        return false;
+      }
+      if (count == 0)
+      {
+        return false;
+      }
+
+      if (lz4 && !this->lz4_.feed(dst, count))
+      {
+        this->fail_("corrupt LZ4 payload");
+        return false;
+      }
+
+      this->payload_pos_ += count;
+      if (this->payload_pos_ < this->header_.payload_size)
+      {
+        return true;
+      }
+
+      if (lz4 && !this->lz4_.is_complete())
+      {
+        this->fail_("LZ4 payload does not fill the frame");
+        return false;
+      }
+      this->finish_();
+      return true;
+    }
+
+    void RawFrameImage::finish_()
+    {
+      this->close_();
+      this->state_ = STATE_IDLE;
+
+      this->last_load_ms_ = millis() - this->load_start_;
+      this->last_transfer_bytes_ = sizeof(this->header_) + this->header_.payload_size;
+
+      if (this->compressed_ != nullptr)
+      {
+        this->compressed_size_ = this->header_.payload_size;
+        ESP_LOGD(TAG, "Loaded %dx%d frame in %ums (%u bytes, held compressed)", this->header_.width,
+                 this->header_.height, this->last_load_ms_, this->last_transfer_bytes_);
+        if (this->displayed_ && !this->expand_())
+        {
+          this->free_compressed_();
+          this->fail_("corrupt LZ4 payload");
+          return;
+        }
+      }
+      else
+      {
+        this->width_ = this->header_.width;
+        this->height_ = this->header_.height;
+        this->data_start_ = this->buffer_;
+        ESP_LOGD(TAG, "Loaded %dx%d frame in %ums (%u bytes%s)", this->width_, this->height_, this->last_load_ms_,
+                 this->last_transfer_bytes_, this->header_.compression == RAW_FRAME_COMPRESSION_LZ4 ? ", LZ4" : "");
+      }
+
+      this->on_finished_callbacks_.call(false);
+    }
+
+    void RawFrameImage::fail_(const char *reason)
+    {
+      ESP_LOGE(TAG, "Loading %s failed: %s", this->source_.c_str(), reason);
+      this->close_();
+      this->state_ = STATE_IDLE;
+      this->on_error_callbacks_.call();
+    }
+
+    bool RawFrameImage::expand_()
+    {
+      size_t size = frame_bytes(this->header_.width, this->header_.height, this->type_);
+      if (!this->allocate_buffer_(size))
+      {
+        ESP_LOGE(TAG, "No memory to expand a %dx%d frame", this->header_.width, this->header_.height);
+        return false;
+      }
+
+      uint32_t start = micros();
+      this->lz4_.reset(this->buffer_, size);
+      if (!this->lz4_.feed(this->compressed_, this->compressed_size_) || !this->lz4_.is_complete())
+      {
+        this->free_buffer_();
+        return false;
+      }
+      this->last_expand_us_ = micros() - start;
+
+      this->width_ = this->header_.width;
+      this->height_ = this->header_.height;
+      this->data_start_ = this->buffer_;
+      ESP_LOGD(TAG, "Expanded %dx%d frame in %uus (%u -> %u bytes)", this->width_, this->height_,
+               this->last_expand_us_, this->compressed_size_, size);
+      return true;
+    }
+
+    void RawFrameImage::collapse_()
+    {
+      this->width_ = 0;
+      this->height_ = 0;
+      this->data_start_ = nullptr;
+      this->free_buffer_();
+    }
+
+    bool RawFrameImage::allocate_buffer_(size_t size)
+    {
+      if (this->buffer_size_ == size)
+      {
+        return true;
+      }
+      this->free_buffer_();
+      this->buffer_ = this->allocator_.allocate(size);
+      if (this->buffer_ == nullptr)
+      {
+        return false;
+      }
+      this->buffer_size_ = size;
+      return true;
+    }
+
+    void RawFrameImage::free_compressed_()
+    {
+      if (this->compressed_ != nullptr)
+      {
+        this->allocator_.deallocate(this->compressed_, this->compressed_capacity_);
+        this->compressed_ = nullptr;
+        this->compressed_capacity_ = 0;
+      }
+      this->compressed_size_ = 0;
+    }
+
+    void RawFrameImage::free_buffer_()
+    {
+      if (this->buffer_ != nullptr)
+      {
+        this->allocator_.deallocate(this->buffer_, this->buffer_size_);
+        this->buffer_ = nullptr;
+        this->buffer_size_ = 0;
+      }
+    }
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SLIDESHOW_RAW_SLOT
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/http_request/http_request.h"
+#include "esphome/components/image/image.h"
+
+#include "slideshow_budget.h"
+#include "slideshow_lz4.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Pre-decoded frame format, written by tools/slideshow_frame.py:
+    //   header: magic "SSRF", version u8, type u8 (image::ImageType),
+    //           compression u8, reserved u8, width u16, height u16, payload size u32
+    //   payload: pixels in image::Image layout, raw or as one LZ4 block
+    enum RawFrameCompression : uint8_t
+    {
+      RAW_FRAME_COMPRESSION_NONE = 0,
+      RAW_FRAME_COMPRESSION_LZ4 = 1,
+    };
+
+    struct RawFrameHeader
+    {
+      uint32_t magic;
+      uint8_t version;
+      uint8_t type;
+      uint8_t compression;
+      uint8_t reserved;
+      uint16_t width;
+      uint16_t height;
+      uint32_t payload_size;
+    } __attribute__((packed));
+
+    // Image loaded from a pre-decoded frame over HTTP or from a file. There is
+    // no decoder: the payload streams straight into the frame buffer, so load
+    // time is bounded by the transfer alone.
+    class RawFrameImage : public Component, public esphome::image::Image
+    {
+    public:
+      explicit RawFrameImage(esphome::image::ImageType type)
+          : esphome::image::Image(nullptr, 0, 0, type, esphome::image::TRANSPARENCY_OPAQUE) {}
+      ~RawFrameImage() { this->release(); }
+
+      void setup() override { this->disable_loop(); }
+      void loop() override;
+      void dump_config() override;
+
+      void set_http_request(http_request::HttpRequestComponent *http) { this->http_ = http; }
+      // Time one loop() may spend streaming (the slideshow's loop budget)
+      void set_time_budget(uint32_t us) { this->time_budget_us_ = us; }
+
+      // Hold LZ4 frames compressed until they are displayed, so prefetched
+      // frames take a fraction of a full frame buffer
+      void set_compressed_residency(bool compressed) { this->compressed_residency_ = compressed; }
+
+      // The frame is expanded while displayed and dropped back to its
+      // compressed form once it is not (compressed residency only)
+      void set_displayed(bool displayed);
+
+      // URL (http:// or https://) or file path
+      void set_source(const std::string &source) { this->source_ = source; }
+      void update();
+      void release();
+
+      bool is_loading() const { return this->state_ != STATE_IDLE; }
+      uint32_t get_last_load_ms() const { return this->last_load_ms_; }
+      size_t get_last_transfer_bytes() const { return this->last_transfer_bytes_; }
+      uint32_t get_last_expand_us() const { return this->last_expand_us_; }
+      size_t get_resident_bytes() const { return this->buffer_size_ + this->compressed_capacity_; }
+
+      void add_on_finished_callback(std::function<void(bool)> &&callback)
+      {
+        this->on_finished_callbacks_.add(std::move(callback));
+      }
+      void add_on_error_callback(std::function<void()> &&callback)
+      {
+        this->on_error_callbacks_.add(std::move(callback));
+      }
+
+    protected:
+      enum State : uint8_t
+      {
+        STATE_IDLE,
+        STATE_HEADER,
+        STATE_PAYLOAD,
+      };
+
+      bool open_();
+      void close_();
+      int read_(uint8_t *buf, size_t len);
+      bool read_header_();
+      bool begin_payload_();
+      bool read_payload_();
+      void finish_();
+      void fail_(const char *reason);
+      bool allocate_buffer_(size_t size);
+      void free_buffer_();
+      bool expand_();
+      void collapse_();
+      void free_compressed_();
+
+      http_request::HttpRequestComponent *http_{nullptr};
+      std::string source_;
+      uint32_t time_budget_us_{8000};
+
+      State state_{STATE_IDLE};
+      std::shared_ptr<http_request::HttpContainer> container_;
+      FILE *file_{nullptr};
+
+      RawFrameHeader header_;
+      size_t header_pos_{0};
+      size_t payload_pos_{0};
+      Lz4StreamDecoder lz4_;
+      std::unique_ptr<uint8_t[]> chunk_; // Compressed input only
+
+      RAMAllocator<uint8_t> allocator_;
+      uint8_t *buffer_{nullptr};
+      size_t buffer_size_{0};
+
+      // Compressed residency: the LZ4 payload as received. header_ describes
+      // it as long as compressed_size_ is set (no load in flight).
+      bool compressed_residency_{false};
+      bool displayed_{false};
+      uint8_t *compressed_{nullptr};
+      size_t compressed_capacity_{0};
+      size_t compressed_size_{0}; // 0 unless a complete frame is held
+
+      uint32_t load_start_{0};
+      uint32_t last_progress_{0};
+      uint32_t last_load_ms_{0};
+      size_t last_transfer_bytes_{0};
+      uint32_t last_expand_us_{0};
+
+      CallbackManager<void(bool)> on_finished_callbacks_;
+      CallbackManager<void()> on_error_callbacks_;
+    };
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
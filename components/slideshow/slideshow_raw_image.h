@@ -0,0 +1,109 @@
+#pragma once
+
+#include "esphome/core/log.h"
+
+#include "slideshow_callbacks.h"
+#include "slideshow_raw_frame.h"
+#include "slideshow_validators.h"
+
+#include <string>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    class RawFrameSlot
+    {
+    public:
+      RawFrameSlot(RawFrameImage *img, OnceCallbackManager *callbacks) : img_(img), callbacks_(callbacks)
+      {
+        this->img_->add_on_finished_callback([this](bool cached)
+                                             {
+                                              this->cached_ = cached;
+                                              this->ready_ = true;
+                                              this->failed_ = false;
+                                              this->callbacks_->call(true); });
+        this->img_->add_on_error_callback([this]()
+                                          {
+                                            this->ready_ = false;
+                                            this->failed_ = true;
+                                            this->callbacks_->call(false); });
+      }
+
+      // The callbacks above point at this adapter, so it must never be copied or moved
+      RawFrameSlot(const RawFrameSlot &) = delete;
+      RawFrameSlot &operator=(const RawFrameSlot &) = delete;
+
+      void set_source(const std::string &source)
+      {
+        this->ready_ = false;
+        this->failed_ = false;
+        this->cached_ = false;
+        this->img_->set_source(source);
+      }
+
+      void update()
+      {
+        this->ready_ = false;
+        this->cached_ = false;
+        this->img_->update();
+      }
+
+      // Raw frames carry no validators to send, so the frame is loaded again
+      // (revalidate is rejected for raw_frame_slots in the configuration)
+      void revalidate(const HttpValidators &validators)
+      {
+        this->update();
+      }
+
+      void release()
+      {
+        this->ready_ = false;
+        this->img_->release();
+      }
+
+      void set_displayed(bool displayed)
+      {
+        this->img_->set_displayed(displayed);
+      }
+
+      size_t get_resident_bytes()
+      {
+        return this->img_->get_resident_bytes();
+      }
+
+      esphome::image::Image *get_image()
+      {
+        return this->img_;
+      }
+
+      bool is_ready()
+      {
+        return this->ready_;
+      }
+
+      bool is_failed()
+      {
+        return this->failed_;
+      }
+
+      bool was_cached()
+      {
+        return this->cached_;
+      }
+
+      HttpValidators get_validators()
+      {
+        return {};
+      }
+
+    protected:
+      RawFrameImage *img_;
+      OnceCallbackManager *callbacks_;
+      bool ready_{false};
+      bool failed_{false};
+      bool cached_{false};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -0,0 +1,261 @@
+#include "slideshow_resample.h"
+
+#ifdef USE_SLIDESHOW_FIT
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    using esphome::image::Image;
+    using esphome::image::ImageType;
+
+    bool FrameResampler::supports(Image *src)
+    {
+      if (src == nullptr || src->get_data_start() == nullptr || src->has_transparency())
+      {
+        return false;
+      }
+      ImageType type = src->get_type();
+      return type == esphome::image::IMAGE_TYPE_RGB565 || type == esphome::image::IMAGE_TYPE_RGB ||
+             type == esphome::image::IMAGE_TYPE_GRAYSCALE;
+    }
+
+    bool FrameResampler::begin(Image *src, FrameBuffer *out, FitMode mode)
+    {
+      out_ = nullptr;
+      if (!supports(src) || out == nullptr || !out->is_allocated() ||
+          out->get_image()->get_type() != esphome::image::IMAGE_TYPE_RGB565)
+      {
+        return false;
+      }
+
+      int src_w = src->get_width();
+      int src_h = src->get_height();
+      int dst_w = out->get_image()->get_width();
+      int dst_h = out->get_image()->get_height();
+      if (src_w <= 0 || src_h <= 0)
+      {
+        return false;
+      }
+
+      // Source window and the output area it is mapped onto
+      float win_x = 0, win_y = 0, win_w = src_w, win_h = src_h;
+      int area_x = 0, area_y = 0, area_w = dst_w, area_h = dst_h;
+      switch (mode)
+      {
+      case FIT_MODE_COVER:
+      {
+        float scale = std::max(static_cast<float>(dst_w) / src_w, static_cast<float>(dst_h) / src_h);
+        win_w = dst_w / scale;
+        win_h = dst_h / scale;
+        win_x = (src_w - win_w) / 2;
+        win_y = (src_h - win_h) / 2;
+        break;
+      }
+      case FIT_MODE_CONTAIN:
+      {
+        float scale = std::min(static_cast<float>(dst_w) / src_w, static_cast<float>(dst_h) / src_h);
+        area_w = std::max(1, std::min(dst_w, static_cast<int>(lroundf(src_w * scale))));
+        area_h = std::max(1, std::min(dst_h, static_cast<int>(lroundf(src_h * scale))));
+        area_x = (dst_w - area_w) / 2;
+        area_y = (dst_h - area_h) / 2;
+        break;
+      }
+      case FIT_MODE_CENTER_CROP:
+        area_w = std::min(src_w, dst_w);
+        area_h = std::min(src_h, dst_h);
+        area_x = (dst_w - area_w) / 2;
+        area_y = (dst_h - area_h) / 2;
+        win_x = (src_w - area_w) / 2;
+        win_y = (src_h - area_h) / 2;
+        win_w = area_w;
+        win_h = area_h;
+        break;
+      }
+
+      build_axis_(axis_x_, win_x, win_w, src_w, area_x, area_w);
+      build_axis_(axis_y_, win_y, win_h, src_h, area_y, area_h);
+      col_begin_ = axis_x_.start.front();
+      col_end_ = axis_x_.start.back() + axis_x_.taps;
+
+      src_type_ = src->get_type();
+      src_data_ = src->get_data_start();
+      src_stride_ = frame_bytes(src_w, 1, src_type_);
+
+      size_t columns = (col_end_ - col_begin_) * 3;
+      row8_.resize(columns);
+      acc_.resize(columns);
+      row16_.resize(columns);
+
+      out_ = out;
+      row_ = 0;
+      return true;
+    }
+
+    void FrameResampler::build_axis_(Axis &axis, float src_offset, float src_length, int src_size, int dst_offset,
+                                     int dst_length)
+    {
+      // Triangle filter: bilinear when enlarging, widened to the scale when shrinking
+      float scale = src_length / dst_length;
+      float radius = std::max(scale, 1.0f);
+      int taps = std::min(static_cast<int>(ceilf(radius * 2)), src_size);
+
+      axis.taps = taps;
+      axis.dst_offset = dst_offset;
+      axis.dst_length = dst_length;
+      axis.start.resize(dst_length);
+      axis.weights.resize(dst_length * taps);
+
+      std::vector<float> weights(taps);
+      for (int i = 0; i < dst_length; i++)
+      {
+        float center = src_offset + (i + 0.5f) * scale - 0.5f;
+        int start = static_cast<int>(floorf(center - radius)) + 1;
+        start = std::max(0, std::min(start, src_size - taps));
+
+        float sum = 0;
+        for (int k = 0; k < taps; k++)
+        {
+          weights[k] = std::max(0.0f, 1.0f - fabsf(start + k - center) / radius);
+          sum += weights[k];
+        }
+
+        int16_t *out = &axis.weights[i * taps];
+        if (sum <= 0)
+        {
+          // Center outside the image: repeat the edge pixel
+          std::fill(out, out + taps, 0);
+          out[center < start ? 0 : taps - 1] = 1 << 14;
+        }
+        else
+        {
+          // Round to Q14 and put the rounding error on the largest tap
+          int total = 0, largest = 0;
+          for (int k = 0; k < taps; k++)
+          {
+            out[k] = static_cast<int16_t>(lroundf(weights[k] / sum * (1 << 14)));
+            total += out[k];
+            if (out[k] > out[largest])
+              largest = k;
+          }
+          out[largest] += (1 << 14) - total;
+        }
+        axis.start[i] = start;
+      }
+    }
+
+    void FrameResampler::unpack_row_(int y)
+    {
+      const uint8_t *src = src_data_ + y * src_stride_;
+      uint8_t *dst = row8_.data();
+      switch (src_type_)
+      {
+      case esphome::image::IMAGE_TYPE_RGB565:
+        // Big endian, expanded to 8 bits per channel
+        for (int x = col_begin_; x < col_end_; x++)
+        {
+          uint16_t pixel = (src[x * 2] << 8) | src[x * 2 + 1];
+          *dst++ = ((pixel >> 11) << 3) | (pixel >> 13);
+          *dst++ = (((pixel >> 5) & 0x3F) << 2) | ((pixel >> 9) & 0x03);
+          *dst++ = ((pixel & 0x1F) << 3) | ((pixel >> 2) & 0x07);
+        }
+        break;
+      case esphome::image::IMAGE_TYPE_RGB:
+        memcpy(dst, src + col_begin_ * 3, (col_end_ - col_begin_) * 3);
+        break;
+      default:
+        for (int x = col_begin_; x < col_end_; x++)
+        {
+          *dst++ = src[x];
+          *dst++ = src[x];
+          *dst++ = src[x];
+        }
+        break;
+      }
+    }
+
+    bool FrameResampler::resample_rows(int max_rows)
+    {
+      if (out_ == nullptr)
+      {
+        return true;
+      }
+
+      int dst_w = out_->get_image()->get_width();
+      int dst_h = out_->get_image()->get_height();
+      int end = std::min(row_ + max_rows, dst_h);
+      size_t columns = acc_.size();
+
+      for (; row_ < end; row_++)
+      {
+        uint8_t *dst = out_->data() + static_cast<size_t>(row_) * dst_w * 2;
+        int yy = row_ - axis_y_.dst_offset;
+        if (yy < 0 || yy >= axis_y_.dst_length)
+        {
+          memset(dst, 0, dst_w * 2);
+          continue;
+        }
+
+        // Vertical pass: weighted sum of source rows, one flat loop per tap
+        const int16_t *wy = &axis_y_.weights[yy * axis_y_.taps];
+        std::fill(acc_.begin(), acc_.end(), 0);
+        for (int k = 0; k < axis_y_.taps; k++)
+        {
+          uint32_t weight = wy[k];
+          if (weight == 0)
+            continue;
+          unpack_row_(axis_y_.start[yy] + k);
+          const uint8_t *in = row8_.data();
+          uint32_t *acc = acc_.data();
+          for (size_t i = 0; i < columns; i++)
+          {
+            acc[i] += weight * in[i];
+          }
+        }
+        // Q14 -> Q8, keeping precision for the horizontal pass
+        for (size_t i = 0; i < columns; i++)
+        {
+          row16_[i] = (acc_[i] + (1 << 5)) >> 6;
+        }
+
+        // Horizontal pass into RGB565
+        memset(dst, 0, axis_x_.dst_offset * 2);
+        dst += axis_x_.dst_offset * 2;
+        for (int xx = 0; xx < axis_x_.dst_length; xx++)
+        {
+          const int16_t *wx = &axis_x_.weights[xx * axis_x_.taps];
+          const uint16_t *in = &row16_[(axis_x_.start[xx] - col_begin_) * 3];
+          uint32_t r = 0, g = 0, b = 0;
+          for (int k = 0; k < axis_x_.taps; k++, in += 3)
+          {
+            r += wx[k] * in[0];
+            g += wx[k] * in[1];
+            b += wx[k] * in[2];
+          }
+          // Q22 -> 8 bit, rounded
+          r = std::min<uint32_t>((r + (1 << 21)) >> 22, 255);
+          g = std::min<uint32_t>((g + (1 << 21)) >> 22, 255);
+          b = std::min<uint32_t>((b + (1 << 21)) >> 22, 255);
+          uint16_t pixel = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+          *dst++ = pixel >> 8;
+          *dst++ = pixel & 0xFF;
+        }
+        memset(dst, 0, (dst_w - axis_x_.dst_offset - axis_x_.dst_length) * 2);
+      }
+
+      if (row_ < dst_h)
+      {
+        return false;
+      }
+      out_ = nullptr;
+      return true;
+    }
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SLIDESHOW_FIT
+
+#include "slideshow_frame.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // How a source is fitted into the target frame
+    enum FitMode : uint8_t
+    {
+      FIT_MODE_COVER = 0,   // Scale to fill, cropping the overflow
+      FIT_MODE_CONTAIN,     // Scale to fit, black bars on the remaining sides
+      FIT_MODE_CENTER_CROP, // No scaling, centered and cropped or padded
+    };
+
+    // Scales and crops an opaque RGB565, RGB or grayscale image into an
+    // RGB565 frame. The filter is separable with fixed-point weights
+    // precomputed per axis: each output row sums a few source rows into a
+    // contiguous accumulator, then each output pixel sums a few accumulator
+    // columns. Work is split into rows so it can run under the loop budget.
+    class FrameResampler
+    {
+    public:
+      static bool supports(esphome::image::Image *src);
+
+      bool begin(esphome::image::Image *src, FrameBuffer *out, FitMode mode);
+      // Resample up to max_rows output rows; returns true once the frame is complete
+      bool resample_rows(int max_rows);
+      void abort() { out_ = nullptr; }
+      bool is_resampling() const { return out_ != nullptr; }
+      // Pixels being read, to detect the source being reloaded underneath
+      const uint8_t *get_source_data() const { return src_data_; }
+
+    protected:
+      // Filter taps for one axis, for each output pixel inside the fitted area
+      struct Axis
+      {
+        int taps{0};
+        int dst_offset{0};
+        int dst_length{0};
+        std::vector<int32_t> start;   // First source pixel per output pixel
+        std::vector<int16_t> weights; // taps weights per output pixel, Q14, summing to 1
+      };
+
+      static void build_axis_(Axis &axis, float src_offset, float src_length, int src_size, int dst_offset,
+                              int dst_length);
+      void unpack_row_(int y);
+
+      Axis axis_x_;
+      Axis axis_y_;
+      int col_begin_{0}; // Source columns read by the horizontal pass
+      int col_end_{0};
+
+      esphome::image::ImageType src_type_{esphome::image::IMAGE_TYPE_RGB565};
+      const uint8_t *src_data_{nullptr};
+      size_t src_stride_{0};
+
+      std::vector<uint8_t> row8_;   // Unpacked source row, RGB per column
+      std::vector<uint32_t> acc_;   // Vertical pass accumulator, Q14
+      std::vector<uint16_t> row16_; // Vertical pass result, Q8
+
+      FrameBuffer *out_{nullptr};
+      int row_{0};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "esphome/components/image/image.h"
+
+#include "slideshow_callbacks.h"
+#include "slideshow_validators.h"
+
+// Only the adapters for slot types used in the configuration are compiled in;
+// __init__.py emits the matching USE_SLIDESHOW_*_SLOT defines.
+#ifdef USE_SLIDESHOW_ONLINE_SLOT
+#include "slideshow_online_image.h"
+#endif
+#ifdef USE_SLIDESHOW_EMBEDDED_SLOT
+#include "slideshow_embedded_image.h"
+#endif
+#ifdef USE_SLIDESHOW_LOCAL_SLOT
+#include "slideshow_local_image.h"
+#endif
+#ifdef USE_SLIDESHOW_RAW_SLOT
+#include "slideshow_raw_image.h"
+#endif
+
+#include <string>
+#include <variant>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // Placeholder held by slots that have not been bound to an image yet
+    class NullSlot
+    {
+    public:
+      void set_source(const std::string &source) {}
+      void update() {}
+      void revalidate(const HttpValidators &validators) {}
+      void release() {}
+      void set_displayed(bool displayed) {}
+      size_t get_resident_bytes() { return 0; }
+      esphome::image::Image *get_image() { return nullptr; }
+      bool is_ready() { return false; }
+      bool is_failed() { return true; }
+      bool was_cached() { return false; }
+      HttpValidators get_validators() { return {}; }
+    };
+
+    using slot_adapter_t = std::variant<NullSlot
+#ifdef USE_SLIDESHOW_ONLINE_SLOT
+                                        ,
+                                        OnlineImageSlot
+#endif
+#ifdef USE_SLIDESHOW_EMBEDDED_SLOT
+                                        ,
+                                        EmbeddedImageSlot
+#endif
+#ifdef USE_SLIDESHOW_LOCAL_SLOT
+                                        ,
+                                        LocalImageSlot
+#endif
+#ifdef USE_SLIDESHOW_RAW_SLOT
+                                        ,
+                                        RawFrameSlot
+#endif
+                                        >;
+
+    // Generic slot (Online, Local, Generated). The adapter is stored inline and
+    // dispatched statically, so slots need no heap allocation or vtable.
+    // Adapters register callbacks pointing at themselves, so slots never move.
+    class SlideshowSlot
+    {
+    public:
+      SlideshowSlot() = default;
+      SlideshowSlot(const SlideshowSlot &) = delete;
+      SlideshowSlot &operator=(const SlideshowSlot &) = delete;
+
+      // Bind the slot to an image component through adapter T. Adapters that
+      // register callbacks are not copyable, which makes emplace construct
+      // them in place rather than in a temporary that is then moved in.
+      template <typename T, typename Img>
+      void bind(Img *img)
+      {
+        this->adapter_.template emplace<T>(img, &this->callbacks_);
+      }
+
+      // The slideshow calls this to load new content
+      void set_source(const std::string &source)
+      {
+        std::visit([&](auto &a)
+                   { a.set_source(source); }, this->adapter_);
+      }
+
+      // Trigger the loading process (download or file read)
+      void update()
+      {
+        std::visit([](auto &a)
+                   { a.update(); }, this->adapter_);
+      }
+
+      // Reload the source the slot already holds. Slots that take HTTP
+      // validators (ETag/Last-Modified) turn this into a conditional request.
+      void revalidate(const HttpValidators &validators)
+      {
+        std::visit([&](auto &a)
+                   { a.revalidate(validators); }, this->adapter_);
+      }
+
+      // Release memory if possible
+      void release()
+      {
+        std::visit([](auto &a)
+                   { a.release(); }, this->adapter_);
+      }
+
+      // Whether the frame is on screen. Slots holding frames in a compact
+      // form expand them while displayed.
+      void set_displayed(bool displayed)
+      {
+        std::visit([&](auto &a)
+                   { a.set_displayed(displayed); }, this->adapter_);
+      }
+
+      // RAM the slot's frame takes, compressed or not (0 while nothing is held)
+      size_t get_resident_bytes()
+      {
+        return std::visit([](auto &a)
+                          { return a.get_resident_bytes(); }, this->adapter_);
+      }
+
+      // Return the underlying generic Image for the Display component
+      esphome::image::Image *get_image()
+      {
+        return std::visit([](auto &a)
+                          { return a.get_image(); }, this->adapter_);
+      }
+
+      // Status check
+      bool is_ready()
+      {
+        return std::visit([](auto &a)
+                          { return a.is_ready(); }, this->adapter_);
+      }
+      bool is_failed()
+      {
+        return std::visit([](auto &a)
+                          { return a.is_failed(); }, this->adapter_);
+      }
+
+      // Whether the last completed load was served from the held copy (e.g. HTTP 304)
+      bool was_cached()
+      {
+        return std::visit([](auto &a)
+                          { return a.was_cached(); }, this->adapter_);
+      }
+
+      // Validators of the frame the last load left, empty if the slot has none
+      HttpValidators get_validators()
+      {
+        return std::visit([](auto &a)
+                          { return a.get_validators(); }, this->adapter_);
+      }
+
+      // Index of the bound adapter type, e.g. to keep statistics per kind of slot
+      size_t type_index() const { return this->adapter_.index(); }
+
+      void callback_once(std::function<void(bool)> &&cb)
+      {
+        this->callbacks_.add(std::move(cb));
+      }
+
+    protected:
+      OnceCallbackManager callbacks_;
+      slot_adapter_t adapter_;
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    enum TraceEventType : uint8_t
+    {
+      TRACE_ADVANCE = 1, // arg: source hash, flags: steps taken (*)
+      TRACE_PREVIOUS,    // arg: source hash
+      TRACE_JUMP_TO,     // arg: source hash, flags: queue index (*)
+      TRACE_ENQUEUE,     // arg: queue size, flags: items added (*)
+      TRACE_QUEUE_CLEAR, //
+      TRACE_LOAD_START,  // arg: item source hash (not the variant's), flags: TRACE_FLAG_REVALIDATE
+      TRACE_READY,       // arg: resident slot bytes, flags: TRACE_FLAG_CACHED
+      TRACE_ERROR,       //
+    };
+
+    static const uint16_t TRACE_FLAG_REVALIDATE = 1 << 0;
+    static const uint16_t TRACE_FLAG_CACHED = 1 << 1;
+
+    // (*) Counts in the 16-bit flags saturate at 0xFFFF
+    inline uint16_t trace_count(size_t count) { return count < 0xFFFF ? count : 0xFFFF; }
+
+    // 12 bytes, little endian on the wire (same layout as in memory on ESP32)
+    struct TraceEvent
+    {
+      uint32_t timestamp; // millis()
+      uint8_t type;
+      uint8_t slot; // 0xFF when not slot related
+      uint16_t flags;
+      uint32_t arg;
+    } __attribute__((packed));
+
+    static const uint8_t TRACE_NO_SLOT = 0xFF;
+    static const uint32_t TRACE_FILE_MAGIC = 0x52545353; // "SSTR"
+    static const uint8_t TRACE_FILE_VERSION = 1;
+
+    // Fixed-size ring buffer of slideshow events; the oldest events are
+    // overwritten once full. Dumped to the log (base64) or a file and replayed
+    // on a host with tools/slideshow_trace.py.
+    class TraceRecorder
+    {
+    public:
+      explicit TraceRecorder(size_t capacity) : events_(capacity) {}
+
+      void record(uint32_t timestamp, TraceEventType type, uint8_t slot, uint16_t flags, uint32_t arg)
+      {
+        if (this->events_.empty())
+          return;
+
+        TraceEvent &event = this->events_[this->head_];
+        event.timestamp = timestamp;
+        event.type = type;
+        event.slot = slot;
+        event.flags = flags;
+        event.arg = arg;
+
+        this->head_ = (this->head_ + 1) % this->events_.size();
+        if (this->count_ < this->events_.size())
+        {
+          this->count_++;
+        }
+        else
+        {
+          this->dropped_++;
+        }
+      }
+
+      size_t size() const { return this->count_; }
+      size_t capacity() const { return this->events_.size(); }
+      uint32_t dropped() const { return this->dropped_; }
+
+      // i-th oldest event
+      const TraceEvent &at(size_t i) const
+      {
+        size_t start = (this->head_ + this->events_.size() - this->count_) % this->events_.size();
+        return this->events_[(start + i) % this->events_.size()];
+      }
+
+      void clear()
+      {
+        this->head_ = 0;
+        this->count_ = 0;
+        this->dropped_ = 0;
+      }
+
+      // Header: magic, version, event count, dropped count; then the events oldest first
+      bool write_to(FILE *file) const
+      {
+        uint32_t header[3] = {TRACE_FILE_MAGIC, TRACE_FILE_VERSION, static_cast<uint32_t>(this->count_)};
+        if (fwrite(header, sizeof(header), 1, file) != 1 || fwrite(&this->dropped_, sizeof(this->dropped_), 1, file) != 1)
+          return false;
+
+        for (size_t i = 0; i < this->count_; i++)
+        {
+          if (fwrite(&this->at(i), sizeof(TraceEvent), 1, file) != 1)
+            return false;
+        }
+        return true;
+      }
+
+    protected:
+      std::vector<TraceEvent> events_;
+      size_t head_{0};
+      size_t count_{0};
+      uint32_t dropped_{0};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
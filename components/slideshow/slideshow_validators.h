@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // HTTP validators of a loaded frame. The pool keeps them by source and
+    // hands them back to the slot holding that source's frame, which sends
+    // them with the conditional request that revalidates it.
+    struct HttpValidators
+    {
+      std::string etag;
+      std::string last_modified;
+
+      bool empty() const { return etag.empty() && last_modified.empty(); }
+    };
+
+  } // namespace slideshow
+} // namespace esphome
@@ -0,0 +1,130 @@
+#include "slideshow_variants.h"
+
+#ifdef USE_SLIDESHOW_VARIANTS
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // "85k", "1.2M" or "90000" in bytes; 0 if not a size
+    static uint32_t parse_size(const std::string &token)
+    {
+      if (token.empty())
+      {
+        return 0;
+      }
+
+      char *end = nullptr;
+      float value = strtof(token.c_str(), &end);
+      if (end == token.c_str() || value <= 0)
+      {
+        return 0;
+      }
+      if (*end == 'k' || *end == 'K')
+      {
+        value *= 1000.0f;
+        end++;
+      }
+      else if (*end == 'M')
+      {
+        value *= 1000000.0f;
+        end++;
+      }
+      if (*end != '\0' || value >= 4e9f)
+      {
+        return 0;
+      }
+      return static_cast<uint32_t>(value);
+    }
+
+    bool parse_variants(const std::string &str, std::vector<SourceVariant> &variants)
+    {
+      std::vector<SourceVariant> parsed;
+      size_t start = 0;
+      while (start < str.size())
+      {
+        // Sources may contain commas, but not ", "
+        size_t end = str.find(", ", start);
+        if (end == std::string::npos)
+        {
+          end = str.size();
+        }
+
+        size_t first = str.find_first_not_of(' ', start);
+        size_t last = str.find_last_not_of(' ', end - 1);
+        if (first == std::string::npos || first >= end || last < first)
+        {
+          return false;
+        }
+        size_t space = str.rfind(' ', last);
+        if (space == std::string::npos || space <= first)
+        {
+          return false;
+        }
+
+        SourceVariant variant;
+        variant.size = parse_size(str.substr(space + 1, last - space));
+        variant.source = str.substr(first, str.find_last_not_of(' ', space) - first + 1);
+        if (variant.size == 0)
+        {
+          return false;
+        }
+        parsed.push_back(std::move(variant));
+        start = end + 2;
+      }
+
+      if (parsed.size() < 2)
+      {
+        return false;
+      }
+      std::sort(parsed.begin(), parsed.end(), [](const SourceVariant &a, const SourceVariant &b)
+                { return a.size < b.size; });
+      variants.swap(parsed);
+      return true;
+    }
+
+    size_t choose_variant(const std::vector<SourceVariant> &variants, uint32_t bytes_per_s, uint32_t available_ms)
+    {
+      // Budget in bytes; 64 bit since both factors can be large
+      uint64_t budget = static_cast<uint64_t>(bytes_per_s) * available_ms / 1000;
+      size_t chosen = 0;
+      for (size_t i = 1; i < variants.size(); i++)
+      {
+        if (variants[i].size <= budget)
+        {
+          chosen = i;
+        }
+      }
+      return chosen;
+    }
+
+    void ThroughputEstimator::record(size_t type, uint32_t bytes, uint32_t elapsed_ms)
+    {
+      if (type >= MAX_TYPES || bytes == 0)
+      {
+        return;
+      }
+
+      uint64_t sample = static_cast<uint64_t>(bytes) * 1000 / std::max<uint32_t>(elapsed_ms, 1);
+      sample = std::max<uint64_t>(std::min<uint64_t>(sample, UINT32_MAX / 4), 1);
+      if (rate_[type] == 0)
+      {
+        rate_[type] = sample;
+        return;
+      }
+      // Weight 1/4: follows a changing link within a few loads, without jumping on one outlier
+      rate_[type] = (rate_[type] * 3 + static_cast<uint32_t>(sample)) / 4;
+    }
+
+    uint32_t ThroughputEstimator::get(size_t type) const
+    {
+      return is_measured(type) ? rate_[type] : initial_;
+    }
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SLIDESHOW_VARIANTS
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome
+{
+  namespace slideshow
+  {
+    // One encoding of an item, with its approximate size in bytes
+    struct SourceVariant
+    {
+      std::string source;
+      uint32_t size{0};
+    };
+
+    // Parse "url 85k, url 310k, url 1.2M" (smallest first once parsed).
+    // Anything else, including a single variant, is left as a plain source.
+    bool parse_variants(const std::string &str, std::vector<SourceVariant> &variants);
+
+    // The largest variant expected to load within available_ms at bytes_per_s,
+    // or the smallest if none is
+    size_t choose_variant(const std::vector<SourceVariant> &variants, uint32_t bytes_per_s, uint32_t available_ms);
+
+    // Load throughput per slot type, as an exponentially weighted moving
+    // average of completed loads
+    class ThroughputEstimator
+    {
+    public:
+      static const size_t MAX_TYPES = 8;
+
+      void set_initial(uint32_t bytes_per_s) { initial_ = bytes_per_s; }
+      uint32_t get_initial() const { return initial_; }
+      void record(size_t type, uint32_t bytes, uint32_t elapsed_ms);
+      // Bytes per second, the initial guess until a load was measured
+      uint32_t get(size_t type) const;
+      bool is_measured(size_t type) const { return type < MAX_TYPES && rate_[type] != 0; }
+
+    protected:
+      uint32_t initial_{100000};
+      uint32_t rate_[MAX_TYPES]{};
+    };
+
+  } // namespace slideshow
+} // namespace esphome
+
+#endif
@@ -0,0 +1,41 @@
+// Time to render a BlurHash preview at panel resolution
+
+#include "harness.h"
+#include "slideshow_preview.h"
+
+using esphome::slideshow::BlurHashDecoder;
+using esphome::slideshow::FrameBuffer;
+using esphome::testing::Stopwatch;
+
+int main()
+{
+  const char *hashes[] = {
+      "LEHV6nWB2yk8pyo0adR*.7kCMdnj", // 4x3 components
+      "|rF?hV%2WCj[ayj[a|j[az_NaeWBj@ayfRayfQfQM{M|azj[azf6fQfQfQIpWXofj[ayj[j[fQayWCoeoeaya}j[ayfQa{oLj?j["
+      "WVj[ayayj[fQoff7azayj[ayj[j[ayofayayayj[fQj[ayayj[ayfjj[j[ayjuayj[", // 9x9 components
+  };
+  const int sizes[][2] = {{800, 480}, {1024, 600}};
+
+  for (const auto &size : sizes)
+  {
+    for (const char *hash : hashes)
+    {
+      FrameBuffer frame;
+      CHECK(frame.allocate(size[0], size[1], esphome::image::IMAGE_TYPE_RGB565));
+      BlurHashDecoder decoder;
+
+      const int runs = 10;
+      Stopwatch watch;
+      for (int run = 0; run < runs; run++)
+      {
+        CHECK(decoder.begin(hash, &frame));
+        while (!decoder.decode_rows(16))
+        {
+        }
+      }
+      printf("%4dx%-4d %dx%d components: %.2f ms per preview\n", size[0], size[1], hash[0] == 'L' ? 4 : 9,
+             hash[0] == 'L' ? 3 : 9, watch.elapsed_us() / runs / 1000.0);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,144 @@
+// Loading a raw frame versus decoding the same picture from a JPEG.
+// online_image decodes into an RGB565 buffer on the device; libjpeg plus the
+// same conversion stands in for that decoder here.
+
+#include "harness.h"
+#include "raw_frame_writer.h"
+
+#include <cstring>
+#include <vector>
+
+#ifdef SLIDESHOW_BENCH_JPEG
+#include <jpeglib.h>
+#endif
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using namespace raw_frame_writer;
+using esphome::testing::Stopwatch;
+
+static const int RUNS = 5;
+
+// Best time of RUNS loads of path into a slot, in microseconds
+static double time_load(const std::string &path, const std::vector<uint8_t> &pixels)
+{
+  RawFrameImage img(image::IMAGE_TYPE_RGB565);
+  img.set_time_budget(8000);
+  img.set_source(path);
+  double best = 1e12;
+  for (int run = 0; run < RUNS; run++)
+  {
+    Stopwatch watch;
+    img.update();
+    testing::run_loop(&img, 100000);
+    best = std::min(best, watch.elapsed_us());
+  }
+  CHECK(img.get_data_start() != nullptr && memcmp(img.get_data_start(), pixels.data(), pixels.size()) == 0);
+  return best;
+}
+
+#ifdef SLIDESHOW_BENCH_JPEG
+static std::vector<uint8_t> jpeg_encode(const std::vector<uint8_t> &rgb, int width, int height, int quality)
+{
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr jerr;
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+  unsigned char *buffer = nullptr;
+  unsigned long size = 0;
+  jpeg_mem_dest(&cinfo, &buffer, &size);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = 3;
+  cinfo.in_color_space = JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, quality, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+  while (cinfo.next_scanline < cinfo.image_height)
+  {
+    JSAMPROW row = const_cast<uint8_t *>(&rgb[static_cast<size_t>(cinfo.next_scanline) * width * 3]);
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  std::vector<uint8_t> out(buffer, buffer + size);
+  free(buffer);
+  return out;
+}
+
+// Decode into an RGB565 frame, row by row
+static void jpeg_decode_rgb565(const std::vector<uint8_t> &jpeg, std::vector<uint8_t> &frame)
+{
+  jpeg_decompress_struct cinfo;
+  jpeg_error_mgr jerr;
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_decompress(&cinfo);
+  jpeg_mem_src(&cinfo, jpeg.data(), jpeg.size());
+  jpeg_read_header(&cinfo, TRUE);
+  cinfo.out_color_space = JCS_RGB;
+  jpeg_start_decompress(&cinfo);
+  std::vector<uint8_t> row(cinfo.output_width * 3);
+  uint8_t *out = frame.data();
+  while (cinfo.output_scanline < cinfo.output_height)
+  {
+    JSAMPROW rows = row.data();
+    jpeg_read_scanlines(&cinfo, &rows, 1);
+    for (size_t i = 0; i < row.size(); i += 3)
+    {
+      uint16_t value = (row[i] >> 3) << 11 | (row[i + 1] >> 2) << 5 | row[i + 2] >> 3;
+      *out++ = value >> 8;
+      *out++ = value & 0xFF;
+    }
+  }
+  jpeg_finish_decompress(&cinfo);
+  jpeg_destroy_decompress(&cinfo);
+}
+#endif
+
+int main()
+{
+  const struct
+  {
+    int width, height;
+  } sizes[] = {{480, 320}, {800, 480}, {1024, 600}};
+
+  printf("%-10s %-6s %-14s %10s %10s\n", "size", "image", "format", "bytes", "ms");
+  for (const auto &size : sizes)
+  {
+    char name[16];
+    snprintf(name, sizeof(name), "%dx%d", size.width, size.height);
+
+    // A photo with sensor noise, and the same picture without it, like flat graphics
+    for (int noise : {6, 0})
+    {
+      const char *content = noise > 0 ? "photo" : "flat";
+      auto rgb = make_photo(size.width, size.height, noise);
+      auto pixels = to_rgb565(rgb);
+
+      for (bool lz4 : {false, true})
+      {
+        auto file = encode_frame(image::IMAGE_TYPE_RGB565, size.width, size.height, pixels, lz4);
+        auto path = temp_path("bench_raw_frame");
+        write_file(path, file);
+        double us = time_load(path, pixels);
+        printf("%-10s %-6s %-14s %10zu %10.2f\n", name, content, lz4 ? "raw frame, LZ4" : "raw frame", file.size(),
+               us / 1000.0);
+        remove(path.c_str());
+      }
+
+#ifdef SLIDESHOW_BENCH_JPEG
+      auto jpeg = jpeg_encode(rgb, size.width, size.height, 85);
+      std::vector<uint8_t> frame(pixels.size());
+      double best = 1e12;
+      for (int run = 0; run < RUNS; run++)
+      {
+        Stopwatch watch;
+        jpeg_decode_rgb565(jpeg, frame);
+        best = std::min(best, watch.elapsed_us());
+      }
+      printf("%-10s %-6s %-14s %10zu %10.2f\n", name, content, "JPEG q85", jpeg.size(), best / 1000.0);
+#endif
+    }
+  }
+  return 0;
+}
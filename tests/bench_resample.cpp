@@ -0,0 +1,50 @@
+// FrameResampler speed for typical photo and panel sizes
+
+#include "harness.h"
+#include "resample_reference.h"
+
+using namespace esphome::slideshow;
+using esphome::image::ImageType;
+using esphome::testing::Stopwatch;
+
+int main()
+{
+  struct Case
+  {
+    int src_w, src_h;
+    ImageType type;
+    int dst_w, dst_h;
+    FitMode mode;
+    const char *name;
+  };
+  const Case cases[] = {
+      {1600, 1200, esphome::image::IMAGE_TYPE_RGB565, 800, 480, FIT_MODE_COVER, "cover, RGB565"},
+      {1024, 768, esphome::image::IMAGE_TYPE_RGB, 800, 480, FIT_MODE_CONTAIN, "contain, RGB"},
+      {640, 480, esphome::image::IMAGE_TYPE_RGB565, 800, 480, FIT_MODE_COVER, "cover, enlarging"},
+      {1000, 700, esphome::image::IMAGE_TYPE_GRAYSCALE, 800, 480, FIT_MODE_CENTER_CROP, "center_crop, grayscale"},
+      {4000, 3000, esphome::image::IMAGE_TYPE_RGB565, 480, 320, FIT_MODE_COVER, "cover, wide filter"},
+  };
+
+  for (const auto &c : cases)
+  {
+    auto src = resample_reference::make_source(c.src_w, c.src_h, c.type);
+    esphome::image::Image img(src.pixels.data(), c.src_w, c.src_h, c.type, esphome::image::TRANSPARENCY_OPAQUE);
+    FrameBuffer frame;
+    CHECK(frame.allocate(c.dst_w, c.dst_h, esphome::image::IMAGE_TYPE_RGB565));
+    FrameResampler resampler;
+
+    // Best of five, rows in the slices the component uses
+    double best = 1e12;
+    for (int run = 0; run < 5; run++)
+    {
+      Stopwatch watch;
+      CHECK(resampler.begin(&img, &frame, c.mode));
+      while (!resampler.resample_rows(8))
+      {
+      }
+      best = std::min(best, watch.elapsed_us());
+    }
+    printf("%4dx%-4d -> %dx%d %-24s %6.2f ms\n", c.src_w, c.src_h, c.dst_w, c.dst_h, c.name, best / 1000.0);
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Compressed residency: how much smaller a held frame is, how many more fit
+// in the same memory, and how long promoting one to the display takes
+
+#include "harness.h"
+#include "raw_frame_writer.h"
+
+#include <cstring>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using namespace raw_frame_writer;
+using esphome::testing::Stopwatch;
+
+static const size_t PSRAM_BYTES = 4 * 1024 * 1024;
+
+int main()
+{
+  const struct
+  {
+    int width, height;
+  } sizes[] = {{480, 320}, {800, 480}, {1024, 600}};
+
+  printf("'in 4MB' counts frames that fit expanded / with compressed residency\n");
+  printf("%-10s %-6s %10s %10s %6s %9s %11s %11s\n", "size", "image", "frame", "held", "ratio", "in 4MB",
+         "promote ms", "demote ms");
+  for (const auto &size : sizes)
+  {
+    char name[16];
+    snprintf(name, sizeof(name), "%dx%d", size.width, size.height);
+
+    for (int noise : {6, 0})
+    {
+      auto pixels = to_rgb565(make_photo(size.width, size.height, noise));
+      auto path = temp_path("bench_residency");
+      write_file(path, encode_frame(image::IMAGE_TYPE_RGB565, size.width, size.height, pixels, true));
+
+      RawFrameImage img(image::IMAGE_TYPE_RGB565);
+      img.set_compressed_residency(true);
+      img.set_source(path);
+      img.update();
+      testing::run_loop(&img, 100000);
+      size_t held = img.get_resident_bytes();
+      CHECK(held > 0 && img.get_data_start() == nullptr);
+
+      // Best of five promotions and demotions
+      double promote = 1e12;
+      double demote = 1e12;
+      for (int run = 0; run < 5; run++)
+      {
+        Stopwatch promote_watch;
+        img.set_displayed(true);
+        promote = std::min(promote, promote_watch.elapsed_us());
+        CHECK(img.get_data_start() != nullptr && memcmp(img.get_data_start(), pixels.data(), pixels.size()) == 0);
+
+        Stopwatch demote_watch;
+        img.set_displayed(false);
+        demote = std::min(demote, demote_watch.elapsed_us());
+      }
+
+      // One frame is always expanded for the display; the rest are held
+      size_t fit_expanded = PSRAM_BYTES / pixels.size();
+      size_t fit_held = 1 + (PSRAM_BYTES - pixels.size() - held) / held;
+      printf("%-10s %-6s %10zu %10zu %5.1fx %4zu/%-4zu %11.2f %11.3f\n", name, noise > 0 ? "photo" : "flat",
+             pixels.size(), held, static_cast<double>(pixels.size()) / held, fit_expanded, fit_held,
+             promote / 1000.0, demote / 1000.0);
+      remove(path.c_str());
+    }
+  }
+  return 0;
+}
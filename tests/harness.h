@@ -0,0 +1,114 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+// Fails the test with the location and the expression
+#define CHECK(cond)                                                            \
+  do                                                                           \
+  {                                                                            \
+    if (!(cond))                                                               \
+    {                                                                          \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      exit(1);                                                                 \
+    }                                                                          \
+  } while (0)
+
+namespace esphome
+{
+  namespace online_image
+  {
+    class OnlineImage;
+  }
+
+  namespace testing
+  {
+    // Run a pending set_timeout() callback of component now. Returns false if none is pending.
+    bool fire_timeout(Component *component, const std::string &name);
+    bool has_timeout(Component *component, const std::string &name);
+    // Run one tick of a set_interval() callback
+    bool fire_interval(Component *component, const std::string &name);
+
+    // Move the clock step_us forward on every micros() call, so a loop budget
+    // smaller than that is spent by the time it is first checked (0: real time)
+    void set_clock_step(uint32_t step_us);
+
+    // Call loop() until the component disables it, at most max_iterations times
+    void run_loop(Component *component, int max_iterations = 100);
+
+    // Stand-in for the HTTP server behind online_image. Each body gets an
+    // ETag; requests carrying the current one are answered 304 without a
+    // body. Requests queue up until serve() answers them, so tests control
+    // when downloads complete.
+    class StandInServer
+    {
+    public:
+      static StandInServer &get();
+
+      // Publish (or replace, with a new ETag) the body at url
+      void put(const std::string &url, size_t body_bytes, int width = 32, int height = 24);
+      void remove(const std::string &url);
+      void reset();
+      // ETag the body at url is served with, empty if there is none
+      std::string etag(const std::string &url) const;
+
+      // Called by online_image
+      void request(online_image::OnlineImage *image, const std::string &url, const std::string &etag);
+
+      // Answer the requests in flight, in order; returns how many were answered
+      size_t serve();
+      // Answer only the requests for url
+      size_t serve(const std::string &url);
+      size_t in_flight() const { return this->pending_.size(); }
+
+      size_t requests{0};
+      size_t conditional{0}; // Requests that carried a validator
+      size_t not_modified{0};
+      size_t not_found{0};
+      size_t bytes_served{0}; // Response bodies only
+
+    protected:
+      struct Resource
+      {
+        size_t bytes;
+        int width;
+        int height;
+        std::string etag;
+      };
+      struct Request
+      {
+        online_image::OnlineImage *image;
+        std::string url;
+        std::string etag;
+      };
+
+      void answer_(const Request &request);
+
+      std::map<std::string, Resource> resources_;
+      std::vector<Request> pending_;
+      uint32_t next_etag_{1};
+    };
+
+    // Wall time for benchmarks
+    class Stopwatch
+    {
+    public:
+      Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+      double elapsed_us() const
+      {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - this->start_).count();
+      }
+
+    protected:
+      std::chrono::steady_clock::time_point start_;
+    };
+  } // namespace testing
+} // namespace esphome
@@ -0,0 +1,153 @@
+#pragma once
+
+// Test frames in the format tools/slideshow_frame.py writes, and an LZ4 block
+// compressor equivalent to the tool's built-in one
+
+#include "slideshow_raw_frame.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace raw_frame_writer
+{
+  using esphome::image::ImageType;
+  using esphome::slideshow::RawFrameHeader;
+
+  // Photo-like 8 bit RGB: smooth gradients, a few hard edges and sensor noise
+  inline std::vector<uint8_t> make_photo(int width, int height, int noise = 6)
+  {
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+    uint32_t seed = 1;
+    uint8_t *p = rgb.data();
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        seed = seed * 1103515245 + 12345;
+        int n = noise > 0 ? static_cast<int>((seed >> 16) % (2 * noise + 1)) - noise : 0;
+        bool inside = (x - width / 3) * (x - width / 3) + (y - height / 2) * (y - height / 2) < height * height / 9;
+        int r = static_cast<int>(120 + 80 * sin(x * 0.01) + 40 * cos(y * 0.02)) + (inside ? 60 : 0);
+        int g = y * 200 / height + (x > width * 2 / 3 ? 40 : 0);
+        int b = static_cast<int>(90 + 60 * sin((x + y) * 0.005));
+        *p++ = std::min(255, std::max(0, r + n));
+        *p++ = std::min(255, std::max(0, g + n));
+        *p++ = std::min(255, std::max(0, b + n));
+      }
+    }
+    return rgb;
+  }
+
+  // RGB565 in image::Image layout (big endian)
+  inline std::vector<uint8_t> to_rgb565(const std::vector<uint8_t> &rgb)
+  {
+    std::vector<uint8_t> out(rgb.size() / 3 * 2);
+    for (size_t i = 0, o = 0; i < rgb.size(); i += 3, o += 2)
+    {
+      uint16_t value = (rgb[i] >> 3) << 11 | (rgb[i + 1] >> 2) << 5 | rgb[i + 2] >> 3;
+      out[o] = value >> 8;
+      out[o + 1] = value & 0xFF;
+    }
+    return out;
+  }
+
+  // Greedy single-probe LZ4 block compressor, as lz4_compress_fallback() in the tool
+  inline std::vector<uint8_t> lz4_compress(const std::vector<uint8_t> &data)
+  {
+    std::vector<uint8_t> out;
+    std::vector<int64_t> table(1 << 16, -1);
+    size_t n = data.size();
+    size_t anchor = 0;
+    size_t pos = 0;
+    // The last 5 bytes are always literals; a match may not start after n - 12
+    size_t limit = n > 12 ? n - 12 : 0;
+
+    auto lengths = [&](size_t value)
+    {
+      while (value >= 255)
+      {
+        out.push_back(255);
+        value -= 255;
+      }
+      out.push_back(value);
+    };
+
+    while (pos < limit)
+    {
+      uint32_t key = data[pos] | data[pos + 1] << 8 | data[pos + 2] << 16 | static_cast<uint32_t>(data[pos + 3]) << 24;
+      uint32_t hash = (key * 2654435761u) >> 16;
+      int64_t candidate = table[hash];
+      table[hash] = pos;
+      if (candidate < 0 || pos - candidate > 0xFFFF ||
+          !std::equal(data.begin() + candidate, data.begin() + candidate + 4, data.begin() + pos))
+      {
+        pos++;
+        continue;
+      }
+
+      size_t length = 4;
+      while (pos + length < n - 5 && data[candidate + length] == data[pos + length])
+        length++;
+
+      size_t literals = pos - anchor;
+      size_t match = length - 4;
+      out.push_back(std::min<size_t>(literals, 15) << 4 | std::min<size_t>(match, 15));
+      if (literals >= 15)
+        lengths(literals - 15);
+      out.insert(out.end(), data.begin() + anchor, data.begin() + pos);
+      out.push_back((pos - candidate) & 0xFF);
+      out.push_back((pos - candidate) >> 8);
+      if (match >= 15)
+        lengths(match - 15);
+      pos += length;
+      anchor = pos;
+    }
+
+    size_t literals = n - anchor;
+    out.push_back(std::min<size_t>(literals, 15) << 4);
+    if (literals >= 15)
+      lengths(literals - 15);
+    out.insert(out.end(), data.begin() + anchor, data.end());
+    return out;
+  }
+
+  // Header and payload of a raw frame file
+  inline std::vector<uint8_t> encode_frame(ImageType type, int width, int height, const std::vector<uint8_t> &pixels,
+                                           bool lz4)
+  {
+    std::vector<uint8_t> payload = lz4 ? lz4_compress(pixels) : pixels;
+    RawFrameHeader header{0x46525353, 1, static_cast<uint8_t>(type),
+                          static_cast<uint8_t>(lz4 ? esphome::slideshow::RAW_FRAME_COMPRESSION_LZ4
+                                                   : esphome::slideshow::RAW_FRAME_COMPRESSION_NONE),
+                          0, static_cast<uint16_t>(width), static_cast<uint16_t>(height),
+                          static_cast<uint32_t>(payload.size())};
+    std::vector<uint8_t> file(reinterpret_cast<uint8_t *>(&header), reinterpret_cast<uint8_t *>(&header) + sizeof(header));
+    file.insert(file.end(), payload.begin(), payload.end());
+    return file;
+  }
+
+  inline void write_file(const std::string &path, const std::vector<uint8_t> &bytes)
+  {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+      fprintf(stderr, "cannot write %s\n", path.c_str());
+      exit(1);
+    }
+    fwrite(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+  }
+
+  // An absolute path, so the stand-in http_request can serve it too
+  inline std::string temp_path(const char *name)
+  {
+    char path[256];
+    snprintf(path, sizeof(path), "/tmp/%s_%d.ssrf", name, static_cast<int>(getpid()));
+    return path;
+  }
+} // namespace raw_frame_writer
@@ -0,0 +1,145 @@
+#pragma once
+
+// Test images and a double precision reference for FrameResampler
+
+#include "slideshow_resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace resample_reference
+{
+  using esphome::image::ImageType;
+  using esphome::slideshow::FitMode;
+
+  // Photo-like test pattern: smooth gradients, fine stripes, hard edges and noise
+  struct Source
+  {
+    std::vector<uint8_t> pixels; // In image::Image layout
+    std::vector<double> rgb;     // The same pixels as 8 bit RGB
+    int width;
+    int height;
+    ImageType type;
+  };
+
+  inline Source make_source(int width, int height, ImageType type)
+  {
+    Source src{{}, std::vector<double>(static_cast<size_t>(width) * height * 3), width, height, type};
+    int bpp = type == esphome::image::IMAGE_TYPE_RGB ? 3 : (type == esphome::image::IMAGE_TYPE_RGB565 ? 2 : 1);
+    src.pixels.resize(static_cast<size_t>(width) * height * bpp);
+    uint32_t noise = 1;
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        noise = noise * 1103515245 + 12345;
+        int r = std::min(255, std::max(0, static_cast<int>(127 + 100 * sin(x * 0.05) + 27 * sin(y * 0.3))));
+        int g = x * 255 / width;
+        int b = std::min(255, ((x / 40 + y / 40) % 2) * 200 + static_cast<int>((noise >> 16) % 20));
+        size_t i = static_cast<size_t>(y) * width + x;
+        if (type == esphome::image::IMAGE_TYPE_RGB565)
+        {
+          uint16_t p = (r >> 3) << 11 | (g >> 2) << 5 | b >> 3;
+          src.pixels[2 * i] = p >> 8;
+          src.pixels[2 * i + 1] = p & 0xFF;
+          // What the resampler unpacks: the top bits repeated into the low ones
+          r = ((p >> 11) << 3) | (p >> 13);
+          g = (((p >> 5) & 63) << 2) | ((p >> 9) & 3);
+          b = ((p & 31) << 3) | ((p >> 2) & 7);
+        }
+        else if (type == esphome::image::IMAGE_TYPE_RGB)
+        {
+          src.pixels[3 * i] = r;
+          src.pixels[3 * i + 1] = g;
+          src.pixels[3 * i + 2] = b;
+        }
+        else
+        {
+          src.pixels[i] = g;
+          r = b = g;
+        }
+        src.rgb[3 * i] = r;
+        src.rgb[3 * i + 1] = g;
+        src.rgb[3 * i + 2] = b;
+      }
+    }
+    return src;
+  }
+
+  using Taps = std::vector<std::pair<int, double>>;
+
+  // Triangle filter taps per output pixel, as FrameResampler defines them
+  inline std::vector<Taps> axis(double offset, double length, int src_size, int dst_length)
+  {
+    std::vector<Taps> out(dst_length);
+    double scale = length / dst_length;
+    double radius = std::max(scale, 1.0);
+    for (int i = 0; i < dst_length; i++)
+    {
+      double center = offset + (i + 0.5) * scale - 0.5;
+      double sum = 0;
+      for (int p = static_cast<int>(floor(center - radius)); p <= static_cast<int>(ceil(center + radius)); p++)
+      {
+        double w = std::max(0.0, 1 - fabs(p - center) / radius);
+        if (w > 0)
+        {
+          out[i].push_back({std::min(std::max(p, 0), src_size - 1), w});
+          sum += w;
+        }
+      }
+      for (auto &tap : out[i])
+        tap.second /= sum;
+    }
+    return out;
+  }
+
+  // The fitted frame as unquantized RGB, black outside the fitted area
+  inline std::vector<double> fit(const Source &src, int dst_w, int dst_h, FitMode mode)
+  {
+    double sw = src.width, sh = src.height;
+    double win_x = 0, win_y = 0, win_w = sw, win_h = sh;
+    int area_x = 0, area_y = 0, area_w = dst_w, area_h = dst_h;
+    if (mode == esphome::slideshow::FIT_MODE_COVER)
+    {
+      double s = std::max(dst_w / sw, dst_h / sh);
+      win_w = dst_w / s;
+      win_h = dst_h / s;
+      win_x = (sw - win_w) / 2;
+      win_y = (sh - win_h) / 2;
+    }
+    else if (mode == esphome::slideshow::FIT_MODE_CONTAIN)
+    {
+      double s = std::min(dst_w / sw, dst_h / sh);
+      area_w = std::min(dst_w, static_cast<int>(lround(sw * s)));
+      area_h = std::min(dst_h, static_cast<int>(lround(sh * s)));
+      area_x = (dst_w - area_w) / 2;
+      area_y = (dst_h - area_h) / 2;
+    }
+    else
+    {
+      area_w = std::min(src.width, dst_w);
+      area_h = std::min(src.height, dst_h);
+      area_x = (dst_w - area_w) / 2;
+      area_y = (dst_h - area_h) / 2;
+      win_x = (src.width - area_w) / 2;
+      win_y = (src.height - area_h) / 2;
+      win_w = area_w;
+      win_h = area_h;
+    }
+
+    std::vector<Taps> ax = axis(win_x, win_w, src.width, area_w);
+    std::vector<Taps> ay = axis(win_y, win_h, src.height, area_h);
+    std::vector<double> out(static_cast<size_t>(dst_w) * dst_h * 3, 0.0);
+    for (int y = area_y; y < area_y + area_h; y++)
+      for (int x = area_x; x < area_x + area_w; x++)
+        for (const auto &ty : ay[y - area_y])
+          for (const auto &tx : ax[x - area_x])
+            for (int c = 0; c < 3; c++)
+              out[(static_cast<size_t>(y) * dst_w + x) * 3 + c] +=
+                  ty.second * tx.second * src.rgb[(static_cast<size_t>(ty.first) * src.width + tx.first) * 3 + c];
+    return out;
+  }
+} // namespace resample_reference
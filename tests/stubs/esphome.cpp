@@ -0,0 +1,355 @@
+// Host implementations of the ESPHome pieces the slideshow uses
+
+#include "harness.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/http_request/http_request.h"
+#include "esphome/components/online_image/online_image.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace esphome
+{
+  namespace setup_priority
+  {
+    const float DATA = 600.0f;
+    const float AFTER_WIFI = 200.0f;
+    const float LATE = -100.0f;
+  } // namespace setup_priority
+
+  static ESPPreferences preferences;
+  ESPPreferences *global_preferences = &preferences;
+
+  static const auto start_time = std::chrono::steady_clock::now();
+  // Added by testing::set_clock_step(), on top of real time
+  static uint64_t clock_offset_us = 0;
+  static uint32_t clock_step_us = 0;
+
+  static uint64_t elapsed_us()
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count() +
+           clock_offset_us;
+  }
+
+  uint32_t millis() { return elapsed_us() / 1000; }
+
+  uint32_t micros()
+  {
+    clock_offset_us += clock_step_us;
+    return elapsed_us();
+  }
+
+  void yield() {}
+
+  uint32_t fnv1_hash(const std::string &str)
+  {
+    uint32_t hash = 2166136261UL;
+    for (char c : str)
+    {
+      hash *= 16777619UL;
+      hash ^= static_cast<uint8_t>(c);
+    }
+    return hash;
+  }
+
+  std::string base64_encode(const uint8_t *buf, size_t buf_len)
+  {
+    static const char CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < buf_len; i += 3)
+    {
+      uint32_t n = buf[i] << 16;
+      if (i + 1 < buf_len)
+        n |= buf[i + 1] << 8;
+      if (i + 2 < buf_len)
+        n |= buf[i + 2];
+      out += CHARS[(n >> 18) & 63];
+      out += CHARS[(n >> 12) & 63];
+      out += i + 1 < buf_len ? CHARS[(n >> 6) & 63] : '=';
+      out += i + 2 < buf_len ? CHARS[n & 63] : '=';
+    }
+    return out;
+  }
+
+  // Scheduler: callbacks are kept per component and name until a test runs them
+
+  using ScheduleKey = std::pair<Component *, std::string>;
+  static std::map<ScheduleKey, std::function<void()>> timeouts;
+  static std::map<ScheduleKey, std::function<void()>> intervals;
+
+  void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f)
+  {
+    intervals[{this, name}] = std::move(f);
+  }
+
+  void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f)
+  {
+    timeouts[{this, name}] = std::move(f);
+  }
+
+  bool Component::cancel_timeout(const std::string &name) { return timeouts.erase({this, name}) > 0; }
+  bool Component::cancel_interval(const std::string &name) { return intervals.erase({this, name}) > 0; }
+
+  // A later test's component may be constructed at the same address
+  Component::~Component()
+  {
+    for (auto *schedule : {&timeouts, &intervals})
+    {
+      for (auto it = schedule->begin(); it != schedule->end();)
+        it = it->first.first == this ? schedule->erase(it) : std::next(it);
+    }
+  }
+
+  namespace testing
+  {
+    void log(int level, const char *tag, const char *format, ...)
+    {
+      static const bool verbose = getenv("SLIDESHOW_TEST_VERBOSE") != nullptr;
+      if (level > 2 && !verbose)
+      {
+        return;
+      }
+      printf("[%s] ", tag);
+      va_list args;
+      va_start(args, format);
+      vprintf(format, args);
+      va_end(args);
+      printf("\n");
+      fflush(stdout); // Keep the log up to a crash
+    }
+
+    void set_clock_step(uint32_t step_us) { clock_step_us = step_us; }
+
+    bool fire_timeout(Component *component, const std::string &name)
+    {
+      auto it = timeouts.find({component, name});
+      if (it == timeouts.end())
+      {
+        return false;
+      }
+      auto f = std::move(it->second);
+      timeouts.erase(it);
+      f();
+      return true;
+    }
+
+    bool has_timeout(Component *component, const std::string &name)
+    {
+      return timeouts.count({component, name}) > 0;
+    }
+
+    bool fire_interval(Component *component, const std::string &name)
+    {
+      auto it = intervals.find({component, name});
+      if (it == intervals.end())
+      {
+        return false;
+      }
+      auto f = it->second;
+      f();
+      return true;
+    }
+
+    void run_loop(Component *component, int max_iterations)
+    {
+      component->enable_loop();
+      for (int i = 0; i < max_iterations && component->is_loop_enabled(); i++)
+      {
+        component->loop();
+      }
+    }
+
+    StandInServer &StandInServer::get()
+    {
+      static StandInServer server;
+      return server;
+    }
+
+    void StandInServer::put(const std::string &url, size_t body_bytes, int width, int height)
+    {
+      this->resources_[url] = Resource{body_bytes, width, height, "\"" + std::to_string(this->next_etag_++) + "\""};
+    }
+
+    void StandInServer::remove(const std::string &url) { this->resources_.erase(url); }
+
+    std::string StandInServer::etag(const std::string &url) const
+    {
+      auto it = this->resources_.find(url);
+      return it != this->resources_.end() ? it->second.etag : "";
+    }
+
+    void StandInServer::reset()
+    {
+      this->resources_.clear();
+      this->pending_.clear();
+      this->requests = 0;
+      this->conditional = 0;
+      this->not_modified = 0;
+      this->not_found = 0;
+      this->bytes_served = 0;
+    }
+
+    void StandInServer::request(online_image::OnlineImage *image, const std::string &url, const std::string &etag)
+    {
+      this->requests++;
+      if (!etag.empty())
+      {
+        this->conditional++;
+      }
+      this->pending_.push_back(Request{image, url, etag});
+    }
+
+    size_t StandInServer::serve()
+    {
+      size_t count = 0;
+      // Answering may queue new requests; those wait for the next call
+      std::vector<Request> pending = std::move(this->pending_);
+      this->pending_.clear();
+      for (const auto &request : pending)
+      {
+        this->answer_(request);
+        count++;
+      }
+      return count;
+    }
+
+    size_t StandInServer::serve(const std::string &url)
+    {
+      size_t count = 0;
+      std::vector<Request> pending = std::move(this->pending_);
+      this->pending_.clear();
+      for (const auto &request : pending)
+      {
+        if (request.url != url)
+        {
+          this->pending_.push_back(request);
+          continue;
+        }
+        this->answer_(request);
+        count++;
+      }
+      return count;
+    }
+
+    void StandInServer::answer_(const Request &request)
+    {
+      auto it = this->resources_.find(request.url);
+      if (it == this->resources_.end())
+      {
+        this->not_found++;
+        request.image->finish_download(404, 0, 0, "");
+        return;
+      }
+      if (!request.etag.empty() && request.etag == it->second.etag)
+      {
+        this->not_modified++;
+        request.image->finish_download(304, 0, 0, request.etag);
+        return;
+      }
+      this->bytes_served += it->second.bytes;
+      request.image->finish_download(200, it->second.width, it->second.height, it->second.etag);
+    }
+  } // namespace testing
+
+  namespace online_image
+  {
+    void OnlineImage::set_url(const std::string &url)
+    {
+      this->url_ = url;
+    }
+
+    void OnlineImage::update()
+    {
+      if (this->downloading_)
+      {
+        ESP_LOGW("online_image", "Image already being updated.");
+        return;
+      }
+      this->downloading_ = true;
+      testing::StandInServer::get().request(this, this->url_, this->etag_);
+    }
+
+    void OnlineImage::release()
+    {
+      // As in online_image, a download that has not allocated its buffer yet keeps going
+      if (this->buffer_)
+      {
+        this->buffer_.reset();
+        this->data_start_ = nullptr;
+        this->width_ = 0;
+        this->height_ = 0;
+        this->etag_.clear();
+        this->last_modified_.clear();
+      }
+    }
+
+    void OnlineImage::finish_download(int status, int width, int height, const std::string &etag)
+    {
+      this->downloading_ = false;
+      if (status == 304)
+      {
+        this->finished_callbacks_.call(true);
+        return;
+      }
+      if (status != 200)
+      {
+        this->error_callbacks_.call();
+        return;
+      }
+      this->buffer_.reset(new uint8_t[width * height * 2]());
+      this->data_start_ = this->buffer_.get();
+      this->width_ = width;
+      this->height_ = height;
+      this->etag_ = etag;
+      this->finished_callbacks_.call(false);
+    }
+  } // namespace online_image
+
+  namespace http_request
+  {
+    class FileContainer : public HttpContainer
+    {
+    public:
+      explicit FileContainer(FILE *file) : file_(file) {}
+      ~FileContainer() override { this->end(); }
+
+      int read(uint8_t *buf, size_t max_len) override
+      {
+        size_t count = fread(buf, 1, max_len, this->file_);
+        return count == 0 ? -1 : static_cast<int>(count);
+      }
+
+      void end() override
+      {
+        if (this->file_ != nullptr)
+        {
+          fclose(this->file_);
+          this->file_ = nullptr;
+        }
+      }
+
+    protected:
+      FILE *file_;
+    };
+
+    std::shared_ptr<HttpContainer> HttpRequestComponent::get(const std::string &url)
+    {
+      size_t path = url.find('/', url.find("://") + 3);
+      FILE *file = path == std::string::npos ? nullptr : fopen(url.c_str() + path, "rb");
+      if (file == nullptr)
+      {
+        auto container = std::make_shared<FileContainer>(nullptr);
+        container->status_code = 404;
+        return container;
+      }
+      auto container = std::make_shared<FileContainer>(file);
+      container->status_code = 200;
+      return container;
+    }
+  } // namespace http_request
+} // namespace esphome
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+namespace esphome
+{
+  namespace http_request
+  {
+    struct Header
+    {
+      std::string name;
+      std::string value;
+    };
+
+    class HttpContainer
+    {
+    public:
+      virtual ~HttpContainer() = default;
+      virtual int read(uint8_t *buf, size_t max_len) = 0;
+      virtual void end() {}
+
+      size_t content_length{0};
+      int status_code{0};
+      uint32_t duration_ms{0};
+    };
+
+    // Serves files from the host file system: the URL path is the file path
+    class HttpRequestComponent : public Component
+    {
+    public:
+      std::shared_ptr<HttpContainer> get(const std::string &url);
+      std::shared_ptr<HttpContainer> get(const std::string &url, const std::list<Header> &request_headers)
+      {
+        return this->get(url);
+      }
+    };
+  } // namespace http_request
+} // namespace esphome
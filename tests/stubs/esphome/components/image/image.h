@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome
+{
+  namespace image
+  {
+    enum ImageType
+    {
+      IMAGE_TYPE_BINARY = 0,
+      IMAGE_TYPE_GRAYSCALE = 1,
+      IMAGE_TYPE_RGB = 2,
+      IMAGE_TYPE_RGB565 = 3,
+    };
+
+    enum Transparency
+    {
+      TRANSPARENCY_OPAQUE = 0,
+      TRANSPARENCY_CHROMA_KEY = 1,
+      TRANSPARENCY_ALPHA_CHANNEL = 2,
+    };
+
+    class Image
+    {
+    public:
+      Image(const uint8_t *data_start, int width, int height, ImageType type, Transparency transparency)
+          : width_(width), height_(height), type_(type), data_start_(data_start), transparency_(transparency) {}
+      virtual ~Image() = default;
+
+      int get_width() const { return this->width_; }
+      int get_height() const { return this->height_; }
+      ImageType get_type() const { return this->type_; }
+      const uint8_t *get_data_start() const { return this->data_start_; }
+      bool has_transparency() const { return this->transparency_ != TRANSPARENCY_OPAQUE; }
+
+    protected:
+      int width_;
+      int height_;
+      ImageType type_;
+      const uint8_t *data_start_;
+      Transparency transparency_;
+    };
+  } // namespace image
+} // namespace esphome
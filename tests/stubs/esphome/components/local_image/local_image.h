@@ -0,0 +1,23 @@
+#pragma once
+
+#include "esphome/components/image/image.h"
+
+#include <functional>
+#include <string>
+
+namespace esphome
+{
+  namespace local_image
+  {
+    // Declared only; no test binds local_image slots
+    class LocalImage : public image::Image
+    {
+    public:
+      void set_file_path(const std::string &path);
+      void load();
+      void release();
+      void add_on_finished_callback(std::function<void(bool)> &&callback);
+      void add_on_error_callback(std::function<void()> &&callback);
+    };
+  } // namespace local_image
+} // namespace esphome
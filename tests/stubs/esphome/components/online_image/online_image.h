@@ -0,0 +1,52 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/image/image.h"
+#include "esphome/components/http_request/http_request.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace esphome
+{
+  namespace online_image
+  {
+    // Downloads go to esphome::testing::StandInServer and complete when it
+    // serves them. Like online_image, update() sends whatever validators the
+    // image holds, set_url() keeps them and only release() clears them, a 304
+    // keeps the frame, and update() is ignored while a download is in flight.
+    class OnlineImage : public Component, public image::Image
+    {
+    public:
+      OnlineImage() : image::Image(nullptr, 0, 0, image::IMAGE_TYPE_RGB565, image::TRANSPARENCY_OPAQUE) {}
+
+      void set_url(const std::string &url);
+      void update();
+      void release();
+
+      void add_on_finished_callback(std::function<void(bool)> &&callback)
+      {
+        this->finished_callbacks_.add(std::move(callback));
+      }
+      void add_on_error_callback(std::function<void()> &&callback) { this->error_callbacks_.add(std::move(callback)); }
+
+      const std::string &get_url() const { return this->url_; }
+      bool is_downloading() const { return this->downloading_; }
+
+      // Called by the stand-in server
+      void finish_download(int status, int width, int height, const std::string &etag);
+
+    protected:
+      std::string url_;
+      std::string etag_;
+      std::string last_modified_;
+      std::unique_ptr<uint8_t[]> buffer_;
+      bool downloading_{false};
+
+      CallbackManager<void(bool)> finished_callbacks_;
+      CallbackManager<void()> error_callbacks_;
+    };
+  } // namespace online_image
+} // namespace esphome
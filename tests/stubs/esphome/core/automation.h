@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+namespace esphome
+{
+  template <typename... Ts>
+  class Trigger
+  {
+  public:
+    void trigger(Ts... x) {}
+  };
+
+  template <typename... Ts>
+  class Action
+  {
+  public:
+    virtual ~Action() = default;
+    virtual void play(const Ts &...x) = 0;
+  };
+
+  template <typename T, typename... X>
+  class TemplatableValue
+  {
+  public:
+    TemplatableValue() = default;
+    TemplatableValue(T value) : value_(value) {}
+    bool has_value() const { return true; }
+    T value(X... x) const { return this->value_; }
+
+  protected:
+    T value_{};
+  };
+} // namespace esphome
+
+#define TEMPLATABLE_VALUE_(type, name)            \
+protected:                                        \
+  TemplatableValue<type, Ts...> name##_{};        \
+                                                  \
+public:                                           \
+  template <typename V>                           \
+  void set_##name(V name) { this->name##_ = name; }
+#define TEMPLATABLE_VALUE(type, name) TEMPLATABLE_VALUE_(type, name)
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace esphome
+{
+  namespace setup_priority
+  {
+    extern const float DATA;
+    extern const float AFTER_WIFI;
+    extern const float LATE;
+  } // namespace setup_priority
+
+  // Timeouts and intervals are only recorded; tests run them through esphome::testing
+  class Component
+  {
+  public:
+    virtual ~Component();
+    virtual void setup() {}
+    virtual void loop() {}
+    virtual void dump_config() {}
+    virtual float get_setup_priority() const { return 0; }
+
+    void mark_failed() { this->failed_ = true; }
+    bool is_failed() const { return this->failed_; }
+    void enable_loop() { this->loop_enabled_ = true; }
+    void disable_loop() { this->loop_enabled_ = false; }
+    void enable_loop_soon_any_context() { this->loop_enabled_ = true; }
+    bool is_loop_enabled() const { return this->loop_enabled_; }
+
+  protected:
+    void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);
+    void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);
+    bool cancel_timeout(const std::string &name);
+    bool cancel_interval(const std::string &name);
+    void defer(std::function<void()> &&f) { f(); }
+
+    bool failed_{false};
+    bool loop_enabled_{true};
+  };
+} // namespace esphome
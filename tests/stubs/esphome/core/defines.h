@@ -0,0 +1,3 @@
+#pragma once
+
+// Features are enabled per test target with compile definitions instead
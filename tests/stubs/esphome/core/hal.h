@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome
+{
+  uint32_t millis();
+  uint32_t micros();
+  void yield();
+} // namespace esphome
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace esphome
+{
+  // Plain heap allocations on the host
+  template <class T>
+  class RAMAllocator
+  {
+  public:
+    enum : uint8_t
+    {
+      NONE = 0,
+      ALLOC_EXTERNAL = 1,
+      ALLOC_INTERNAL = 2,
+      ALLOW_FAILURE = 4,
+    };
+
+    RAMAllocator(uint8_t flags = 0) {}
+    T *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T))); }
+    void deallocate(T *p, size_t n) { ::operator delete(p); }
+  };
+
+  uint32_t fnv1_hash(const std::string &str);
+  std::string base64_encode(const uint8_t *buf, size_t buf_len);
+
+  template <typename... Ts>
+  class CallbackManager;
+
+  template <typename... Ts>
+  class CallbackManager<void(Ts...)>
+  {
+  public:
+    void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+    void call(Ts... args)
+    {
+      for (auto &cb : this->callbacks_)
+        cb(args...);
+    }
+    size_t size() const { return this->callbacks_.size(); }
+
+  protected:
+    std::vector<std::function<void(Ts...)>> callbacks_;
+  };
+} // namespace esphome
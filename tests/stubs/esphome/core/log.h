@@ -0,0 +1,18 @@
+#pragma once
+
+// Errors and warnings are printed; everything else only with SLIDESHOW_TEST_VERBOSE set
+namespace esphome
+{
+  namespace testing
+  {
+    void log(int level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+  } // namespace testing
+} // namespace esphome
+
+#define ESP_LOGE(tag, ...) esphome::testing::log(1, tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) esphome::testing::log(2, tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) esphome::testing::log(3, tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) esphome::testing::log(3, tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) esphome::testing::log(4, tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) esphome::testing::log(5, tag, __VA_ARGS__)
+#define YESNO(b) ((b) ? "YES" : "NO")
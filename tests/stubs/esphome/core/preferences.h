@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace esphome
+{
+  // Preferences live in memory for the life of the process, so a component
+  // set up again with the same key finds what the last one saved, as after
+  // a reboot
+  class ESPPreferenceObject
+  {
+  public:
+    ESPPreferenceObject() = default;
+    explicit ESPPreferenceObject(std::vector<uint8_t> *data) : data_(data) {}
+
+    template <typename T>
+    bool save(const T *src)
+    {
+      if (this->data_ == nullptr)
+        return false;
+      auto *bytes = reinterpret_cast<const uint8_t *>(src);
+      this->data_->assign(bytes, bytes + sizeof(T));
+      return true;
+    }
+    template <typename T>
+    bool load(T *dest)
+    {
+      if (this->data_ == nullptr || this->data_->size() != sizeof(T))
+        return false;
+      memcpy(dest, this->data_->data(), sizeof(T));
+      return true;
+    }
+
+  protected:
+    std::vector<uint8_t> *data_{nullptr};
+  };
+
+  class ESPPreferences
+  {
+  public:
+    template <typename T>
+    ESPPreferenceObject make_preference(uint32_t type, bool in_flash = false)
+    {
+      return ESPPreferenceObject(&this->stored_[type]);
+    }
+    bool sync() { return true; }
+
+    // Forget everything, as a fresh flash
+    void reset() { this->stored_.clear(); }
+
+  protected:
+    std::map<uint32_t, std::vector<uint8_t>> stored_;
+  };
+
+  extern ESPPreferences *global_preferences;
+} // namespace esphome
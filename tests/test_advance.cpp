@@ -0,0 +1,137 @@
+// Readiness-gated advances recover from items that fail to load
+
+#include "harness.h"
+#include "slideshow.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static void setup_slideshow(SlideshowComponent &slideshow, online_image::OnlineImage *images, size_t count)
+{
+  slideshow.set_slot_count(count);
+  slideshow.reserve_image_slots(count);
+  for (size_t i = 0; i < count; i++)
+    slideshow.add_image_slot(&images[i]);
+  slideshow.set_advance_interval(1);
+  slideshow.set_refresh_interval(0);
+  slideshow.set_advance_mode(ADVANCE_MODE_WHEN_READY);
+  slideshow.set_prefetch_ahead(2);
+  slideshow.setup();
+}
+
+// Load what the window asks for until nothing is left to request
+static void settle(SlideshowComponent &slideshow)
+{
+  auto &server = StandInServer::get();
+  do
+  {
+    testing::run_loop(&slideshow);
+  } while (server.serve() > 0);
+  testing::run_loop(&slideshow);
+}
+
+// The next item 404s before the timer fires: the advance skips it at once
+static void test_failed_next_is_skipped()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (const char *url : {"http://a", "http://c", "http://d", "http://e"})
+    server.put(url, 1000);
+
+  online_image::OnlineImage images[4];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 4);
+
+  int advances = 0;
+  slideshow.add_on_advance_callback([&](size_t index)
+                                    {
+    // Only fires with a frame to draw
+    CHECK(slideshow.get_current_image() != nullptr);
+    advances++; });
+
+  slideshow.enqueue({"http://a", "http://b", "http://c", "http://d", "http://e"});
+  settle(slideshow);
+  CHECK(server.not_found == 1);
+
+  CHECK(testing::fire_interval(&slideshow, "advance"));
+  CHECK(advances == 1);
+  CHECK(slideshow.current_index() == 2);
+  CHECK(!slideshow.is_advance_pending());
+
+  // b stays failed while it is the previous item, so it is not requested again
+  settle(slideshow);
+  CHECK(server.not_found == 1);
+
+  // Once it comes round again it gets another try, and is skipped again
+  for (int i = 0; i < 3; i++)
+  {
+    CHECK(testing::fire_interval(&slideshow, "advance"));
+    settle(slideshow);
+  }
+  CHECK(slideshow.current_index() % 5 == 0);
+  CHECK(server.not_found == 2);
+  CHECK(testing::fire_interval(&slideshow, "advance"));
+  CHECK(slideshow.current_index() % 5 == 2);
+  CHECK(advances == 5);
+}
+
+// The next item fails while a timed advance is waiting for it
+static void test_failure_while_waiting()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (const char *url : {"http://w", "http://x", "http://y", "http://z"})
+    server.put(url, 1000);
+
+  online_image::OnlineImage images[4];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 4);
+  slideshow.enqueue({"http://w", "http://x", "http://y", "http://z"});
+  testing::run_loop(&slideshow);
+  server.serve("http://w");
+
+  CHECK(testing::fire_interval(&slideshow, "advance"));
+  CHECK(slideshow.is_advance_pending());
+  CHECK(testing::has_timeout(&slideshow, "ready_grace"));
+  CHECK(slideshow.current_index() == 0);
+
+  // y loads, then x turns out to be gone: the advance goes to y without waiting out the grace period
+  server.serve("http://y");
+  server.remove("http://x");
+  server.serve("http://x");
+  CHECK(!slideshow.is_advance_pending());
+  CHECK(!testing::has_timeout(&slideshow, "ready_grace"));
+  CHECK(slideshow.current_index() == 2);
+}
+
+// The next item is just slow: after the grace period a ready one further ahead is shown
+static void test_grace_period_skips_slow_item()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (const char *url : {"http://p", "http://q", "http://r", "http://s"})
+    server.put(url, 1000);
+
+  online_image::OnlineImage images[4];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 4);
+  slideshow.enqueue({"http://p", "http://q", "http://r", "http://s"});
+  testing::run_loop(&slideshow);
+  server.serve("http://p");
+  server.serve("http://r");
+
+  CHECK(testing::fire_interval(&slideshow, "advance"));
+  CHECK(slideshow.current_index() == 0);
+  CHECK(testing::fire_timeout(&slideshow, "ready_grace"));
+  CHECK(slideshow.current_index() == 2);
+}
+
+int main()
+{
+  test_failed_next_is_skipped();
+  test_failure_while_waiting();
+  test_grace_period_skips_slow_item();
+  printf("PASS\n");
+  return 0;
+}
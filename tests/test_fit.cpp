@@ -0,0 +1,58 @@
+// Fitting to the display never leaves an advanced-to item without a frame
+
+#include "harness.h"
+#include "slideshow.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+
+int main()
+{
+  static std::vector<uint8_t> pixels[4];
+  std::vector<image::Image> images;
+  images.reserve(4);
+  for (int i = 0; i < 4; i++)
+  {
+    pixels[i].assign(64 * 48 * 2, 0x10 * (i + 1));
+    images.emplace_back(pixels[i].data(), 64, 48, image::IMAGE_TYPE_RGB565, image::TRANSPARENCY_OPAQUE);
+  }
+
+  SlideshowComponent slideshow;
+  slideshow.set_slot_count(4);
+  slideshow.reserve_image_slots(4);
+  for (auto &img : images)
+    slideshow.add_image_slot(&img);
+  slideshow.set_refresh_interval(0);
+  slideshow.set_fit(40, 30, FIT_MODE_COVER);
+
+  int advances = 0;
+  slideshow.add_on_advance_callback([&](size_t index)
+                                    {
+    // The next item was ready, so there is something to draw right away
+    SlideshowSlot *current = slideshow.get_current_image();
+    CHECK(current != nullptr);
+    CHECK(current->get_image()->get_width() == 64);
+    advances++; });
+
+  slideshow.setup();
+  slideshow.enqueue({"a", "b", "c", "d"});
+  testing::run_loop(&slideshow);
+
+  SlideshowSlot *current = slideshow.get_current_image();
+  CHECK(current != nullptr);
+  CHECK(current->get_image()->get_width() == 40 && current->get_image()->get_height() == 30);
+
+  slideshow.advance();
+  CHECK(advances == 1);
+  // Still fitting: the unscaled image of the new item
+  current = slideshow.get_current_image();
+  CHECK(current != nullptr && current->get_image()->get_data_start() == pixels[1].data());
+
+  testing::run_loop(&slideshow);
+  current = slideshow.get_current_image();
+  CHECK(current != nullptr && current->get_image()->get_width() == 40);
+  CHECK(current->get_image()->get_data_start()[0] == pixels[1][0]);
+
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,191 @@
+// Frame handoff: the front and back frames pin their slots, a swap keeps the
+// old frame pinned until the display completes it, and no pin outlives its
+// frame when items are removed, jumped over or the queue is rebuilt
+
+#include "harness.h"
+#include "slideshow.h"
+#include "slideshow_pool.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 4;
+static const std::vector<std::string> URLS = {"http://a", "http://b", "http://c",
+                                              "http://d", "http://e", "http://f"};
+
+struct Fixture
+{
+  Fixture()
+  {
+    auto &server = StandInServer::get();
+    server.reset();
+    for (auto &url : URLS)
+      server.put(url, 1000);
+    for (auto url : {"http://x", "http://y", "http://z"})
+      server.put(url, 1000);
+
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &image : images)
+      slideshow.add_image_slot(&image);
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(0);
+    slideshow.setup();
+  }
+
+  void settle()
+  {
+    auto &server = StandInServer::get();
+    do
+    {
+      testing::run_loop(&slideshow);
+    } while (server.serve() > 0);
+    testing::run_loop(&slideshow);
+  }
+
+  // Every pinned slot is behind the front or the back frame, and every
+  // frame's slot is pinned; returns how many slots are pinned
+  size_t check_pins()
+  {
+    auto *pool = slideshow.get_pool();
+    const auto &front = slideshow.get_front_frame();
+    const auto &back = slideshow.get_back_frame();
+    size_t pinned = 0;
+    size_t framed = 0;
+    for (size_t i = 0; i < SLOTS; i++)
+    {
+      auto *img = pool->get_slot(i)->get_image();
+      bool behind_frame = (front.data != nullptr && front.image == img) || (back.data != nullptr && back.image == img);
+      CHECK(pool->is_pinned(i) == behind_frame);
+      pinned += pool->is_pinned(i);
+      framed += behind_frame;
+    }
+    CHECK(pinned == framed);
+    return pinned;
+  }
+
+  // The front frame is the current item, the back frame the next one
+  void check_staged()
+  {
+    CHECK(!slideshow.is_swap_pending());
+    size_t index = slideshow.current_index() % slideshow.queue_size();
+    CHECK(slideshow.get_front_frame().item_id == slideshow.get_item_id(index));
+    CHECK(slideshow.get_back_frame().item_id == slideshow.get_item_id((index + 1) % slideshow.queue_size()));
+    CHECK(check_pins() == 2);
+  }
+
+  online_image::OnlineImage images[SLOTS];
+  SlideshowComponent slideshow;
+};
+
+// Staging, swapping on advance, and unpinning once the display lets go
+static void test_swap()
+{
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+  slideshow.enqueue(URLS);
+  fixture.settle();
+  fixture.check_staged();
+
+  // The old front frame stays pinned as the back frame until the swap completes
+  uint32_t shown = slideshow.get_front_frame().item_id;
+  CHECK(testing::fire_interval(&slideshow, "advance"));
+  CHECK(slideshow.is_swap_pending());
+  CHECK(slideshow.get_back_frame().item_id == shown);
+  CHECK(fixture.check_pins() == 2);
+  fixture.settle();
+  CHECK(slideshow.is_swap_pending());
+
+  slideshow.complete_swap();
+  fixture.settle();
+  fixture.check_staged();
+
+  // A display that never confirms: the timeout lets go of the old frame
+  slideshow.advance();
+  CHECK(slideshow.is_swap_pending());
+  CHECK(testing::fire_timeout(&slideshow, "frame_swap"));
+  fixture.settle();
+  fixture.check_staged();
+}
+
+// Removing the staged or the current item, and jumping, leave no stray pins
+static void test_edits()
+{
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+  slideshow.enqueue(URLS);
+  fixture.settle();
+
+  // The staged next item goes: the item after it is staged instead
+  uint32_t staged = slideshow.get_back_frame().item_id;
+  CHECK(slideshow.remove_item(staged));
+  fixture.settle();
+  fixture.check_staged();
+  CHECK(slideshow.get_back_frame().item_id != staged);
+
+  // The current item goes: the next one swaps in, the removed frame stays
+  // on screen until the display lets go of it
+  uint32_t current = slideshow.current_item_id();
+  CHECK(slideshow.remove_item(current));
+  CHECK(fixture.check_pins() == 2);
+  slideshow.complete_swap();
+  fixture.settle();
+  fixture.check_staged();
+  CHECK(slideshow.get_front_frame().item_id != current);
+
+  // Jumping to an item that is not loaded keeps the old frame until it is
+  slideshow.jump_to(3);
+  CHECK(fixture.check_pins() >= 1);
+  fixture.settle();
+  CHECK(slideshow.is_swap_pending());
+  slideshow.complete_swap();
+  fixture.settle();
+  fixture.check_staged();
+
+  // Removing the last items one by one
+  while (slideshow.queue_size() > 1)
+  {
+    slideshow.remove_item(slideshow.current_item_id());
+    slideshow.complete_swap();
+    fixture.settle();
+    fixture.check_pins();
+  }
+  slideshow.remove_item(slideshow.current_item_id());
+  slideshow.complete_swap();
+  fixture.settle();
+  CHECK(fixture.check_pins() <= 1);
+}
+
+// A refresh that rebuilds the queue lets go of every frame of the old one
+static void test_refresh()
+{
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+  slideshow.add_on_refresh_callback([&](size_t)
+                                    {
+    slideshow.clear_queue();
+    CHECK(fixture.check_pins() == 0);
+    slideshow.enqueue({"http://x", "http://y", "http://z"}); });
+  slideshow.enqueue(URLS);
+  fixture.settle();
+  fixture.check_staged();
+
+  slideshow.refresh();
+  fixture.settle();
+  fixture.check_staged();
+  CHECK(slideshow.get_front_frame().item_id == slideshow.get_item_id(0));
+
+  slideshow.clear_queue();
+  CHECK(fixture.check_pins() == 0);
+  CHECK(slideshow.get_front_frame().data == nullptr && slideshow.get_back_frame().data == nullptr);
+}
+
+int main()
+{
+  test_swap();
+  test_edits();
+  test_refresh();
+  printf("PASS\n");
+  return 0;
+}
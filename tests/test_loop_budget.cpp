@@ -0,0 +1,116 @@
+// Loop budget: queued loads start only while the iteration's budget lasts,
+// and each iteration's time lands in the loop-time histogram
+
+#include "harness.h"
+#include "slideshow.h"
+#include "slideshow_pool.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 3;
+static const std::vector<std::string> URLS = {"http://a", "http://b", "http://c"};
+
+struct Fixture
+{
+  Fixture()
+  {
+    auto &server = StandInServer::get();
+    server.reset();
+    for (auto &url : URLS)
+      server.put(url, 1000);
+
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &image : images)
+      slideshow.add_image_slot(&image);
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(0);
+    slideshow.setup();
+  }
+
+  online_image::OnlineImage images[SLOTS];
+  SlideshowComponent slideshow;
+};
+
+// The pool starts no load once the budget is spent, not even a first one
+static void test_load_budget()
+{
+  auto &server = StandInServer::get();
+  Fixture fixture;
+  auto *pool = fixture.slideshow.get_pool();
+  // An iteration whose budget is spent maps the window, but starts no load
+  fixture.slideshow.enqueue(URLS);
+  testing::set_clock_step(1000);
+  fixture.slideshow.set_loop_budget(1);
+  fixture.slideshow.loop();
+  CHECK(server.requests == 0);
+  CHECK(fixture.slideshow.is_loop_enabled());
+
+  {
+    TimeBudget spent(1);
+    CHECK(pool->process_loads(&spent));
+    CHECK(server.requests == 0);
+  }
+
+  // Each budget check moves the clock 1ms: two checks fit in 2.5ms
+  {
+    TimeBudget budget(2500);
+    CHECK(pool->process_loads(&budget));
+    CHECK(server.requests == 2);
+  }
+
+  testing::set_clock_step(0);
+  CHECK(!pool->process_loads(nullptr));
+  CHECK(server.requests == SLOTS);
+}
+
+// Iterations are counted in the histogram bucket of their duration
+static void test_loop_time_histogram()
+{
+  auto &server = StandInServer::get();
+  Fixture fixture;
+  const auto &stats = fixture.slideshow.get_stats();
+  fixture.slideshow.enqueue(URLS);
+  do
+  {
+    testing::run_loop(&fixture.slideshow);
+  } while (server.serve() > 0);
+  testing::run_loop(&fixture.slideshow);
+  CHECK(!fixture.slideshow.is_loop_enabled());
+
+  // With nothing to do, an iteration reads the clock only at its start and
+  // end, so it lasts one clock step
+  uint32_t before[LOOP_TIME_BUCKETS];
+  std::copy(std::begin(stats.loop_time_histogram), std::end(stats.loop_time_histogram), before);
+  uint32_t over_budget = stats.loops_over_budget;
+  fixture.slideshow.set_loop_budget(2500);
+  testing::set_clock_step(300);
+  fixture.slideshow.loop();
+  testing::set_clock_step(1500);
+  fixture.slideshow.loop();
+  fixture.slideshow.loop();
+  CHECK(stats.loop_time_histogram[0] == before[0] + 1); // < 500us
+  CHECK(stats.loop_time_histogram[2] == before[2] + 2); // 1000-2000us
+  CHECK(stats.loops_over_budget == over_budget);
+
+  testing::set_clock_step(6000);
+  fixture.slideshow.loop();
+  CHECK(stats.loop_time_histogram[4] == before[4] + 1); // 5000-10000us
+  CHECK(stats.loops_over_budget == over_budget + 1);
+  CHECK(stats.loop_time_max_us >= 6000);
+
+  testing::set_clock_step(0);
+}
+
+int main()
+{
+  test_load_budget();
+  test_loop_time_histogram();
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,138 @@
+// Loop sleep: loop() disables itself once there is nothing to do, also while
+// downloads are in flight, and a timer, navigation or a load completion
+// enables it again
+
+#include "harness.h"
+#include "slideshow.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 3;
+static const std::vector<std::string> URLS = {"http://a", "http://b", "http://c", "http://d", "http://e"};
+
+// Run loop() only while it stays enabled, as the scheduler would, unlike
+// testing::run_loop() which enables it first; returns the iterations run
+static int run_while_enabled(Component *component)
+{
+  int iterations = 0;
+  while (component->is_loop_enabled())
+  {
+    component->loop();
+    CHECK(++iterations < 100);
+  }
+  return iterations;
+}
+
+struct Fixture
+{
+  Fixture()
+  {
+    auto &server = StandInServer::get();
+    server.reset();
+    for (auto &url : URLS)
+      server.put(url, 1000);
+
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &image : images)
+      slideshow.add_image_slot(&image);
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(0);
+    slideshow.setup();
+  }
+
+  // Answer every download, running the loop only when something woke it
+  void settle()
+  {
+    auto &server = StandInServer::get();
+    do
+    {
+      run_while_enabled(&slideshow);
+    } while (server.serve() > 0);
+    run_while_enabled(&slideshow);
+  }
+
+  // The loop went to sleep, and an event woke it exactly once
+  void check_woken(uint32_t wakeups)
+  {
+    CHECK(slideshow.is_loop_enabled());
+    CHECK(slideshow.get_stats().loop_wakeups == wakeups + 1);
+  }
+
+  online_image::OnlineImage images[SLOTS];
+  SlideshowComponent slideshow;
+};
+
+int main()
+{
+  auto &server = StandInServer::get();
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+  const auto &stats = slideshow.get_stats();
+
+  // Nothing queued: the first iteration goes to sleep
+  testing::run_loop(&slideshow);
+  CHECK(!slideshow.is_loop_enabled());
+  CHECK(stats.loop_sleeps == 1);
+
+  // Enqueueing wakes it; it sleeps again while the downloads are in flight
+  uint32_t wakeups = stats.loop_wakeups;
+  slideshow.enqueue(URLS);
+  fixture.check_woken(wakeups);
+  run_while_enabled(&slideshow);
+  CHECK(server.in_flight() == SLOTS);
+  CHECK(!slideshow.is_loop_enabled());
+
+  // Each completion wakes it, and it sleeps once the window is loaded
+  wakeups = stats.loop_wakeups;
+  CHECK(server.serve("http://a") == 1);
+  fixture.check_woken(wakeups);
+  fixture.settle();
+  CHECK(!slideshow.is_loop_enabled());
+  CHECK(slideshow.get_current_image() != nullptr);
+
+  // The advance timer. An appended item wraps around to be the previous one,
+  // and its completion arriving before the loop runs is not counted again.
+  server.put("http://z", 1000);
+  slideshow.enqueue({"http://z"});
+  run_while_enabled(&slideshow);
+  CHECK(server.in_flight() == 1);
+  wakeups = stats.loop_wakeups;
+  CHECK(testing::fire_interval(&slideshow, "advance"));
+  fixture.check_woken(wakeups);
+  CHECK(server.serve() == 1);
+  fixture.check_woken(wakeups);
+  CHECK(run_while_enabled(&slideshow) <= 2);
+  CHECK(!slideshow.is_loop_enabled());
+  fixture.settle();
+  CHECK(slideshow.current_index() == 1);
+
+  // Navigation
+  wakeups = stats.loop_wakeups;
+  slideshow.advance();
+  fixture.check_woken(wakeups);
+  fixture.settle();
+  CHECK(slideshow.current_index() == 2);
+
+  wakeups = stats.loop_wakeups;
+  slideshow.jump_to(0);
+  fixture.check_woken(wakeups);
+  fixture.settle();
+  CHECK(slideshow.current_index() == 0);
+
+  // A suspended slideshow stays asleep; resuming with work left wakes it
+  slideshow.suspend(true);
+  wakeups = stats.loop_wakeups;
+  slideshow.jump_to(3);
+  CHECK(!slideshow.is_loop_enabled() && stats.loop_wakeups == wakeups);
+  slideshow.suspend(false);
+  fixture.check_woken(wakeups);
+  fixture.settle();
+  CHECK(!slideshow.is_loop_enabled());
+  CHECK(slideshow.get_current_image() != nullptr);
+
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,194 @@
+// Media directory revalidation: removed files leave the queue, files are
+// queued once, files rewritten in place are noticed and an interrupted save
+// is recovered
+
+#include "harness.h"
+#include "slideshow.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <algorithm>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 3;
+
+// Exposes the queue so the test can compare sources
+class MediaSlideshow : public SlideshowComponent
+{
+public:
+  std::vector<std::string> sources() const
+  {
+    std::vector<std::string> sources;
+    for (const auto &item : this->queue_)
+      sources.push_back(item.source);
+    std::sort(sources.begin(), sources.end());
+    return sources;
+  }
+};
+
+struct Fixture
+{
+  Fixture(const std::string &directory, std::function<void(MediaSlideshow &)> on_refresh = nullptr)
+  {
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &image : images)
+      slideshow.add_image_slot(&image);
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(1);
+    slideshow.set_media_directory(directory);
+    if (on_refresh)
+      slideshow.add_on_refresh_callback([this, on_refresh](size_t)
+                                        { on_refresh(this->slideshow); });
+    slideshow.setup();
+    testing::run_loop(&slideshow);
+  }
+
+  // Walk the directory again, as the refresh interval does
+  void revalidate()
+  {
+    CHECK(testing::fire_interval(&slideshow, "refresh"));
+    testing::run_loop(&slideshow);
+    CHECK(!slideshow.get_media_index()->is_revalidating());
+  }
+
+  const MediaIndex::Entry *entry(const std::string &name)
+  {
+    for (const auto &entry : slideshow.get_media_index()->entries())
+      if (entry.name == name)
+        return &entry;
+    return nullptr;
+  }
+
+  online_image::OnlineImage images[SLOTS];
+  MediaSlideshow slideshow;
+};
+
+static void write_file(const std::string &path, size_t bytes)
+{
+  FILE *file = fopen(path.c_str(), "wb");
+  CHECK(file != nullptr);
+  std::string body(bytes, 'x');
+  fwrite(body.data(), body.size(), 1, file);
+  fclose(file);
+}
+
+static time_t get_mtime(const std::string &path)
+{
+  struct stat st;
+  CHECK(stat(path.c_str(), &st) == 0);
+  return st.st_mtime;
+}
+
+static void set_mtime(const std::string &path, time_t mtime)
+{
+  struct utimbuf times{mtime, mtime};
+  CHECK(utime(path.c_str(), &times) == 0);
+}
+
+int main()
+{
+  StandInServer::get().reset();
+  char dir_name[64];
+  snprintf(dir_name, sizeof(dir_name), "/tmp/test_media_index_%d", static_cast<int>(getpid()));
+  const std::string dir = dir_name;
+  mkdir(dir.c_str(), 0755);
+  const std::string a = dir + "/a.jpg", b = dir + "/b.jpg", c = dir + "/c.png";
+  write_file(a, 100);
+  write_file(b, 200);
+  write_file(c, 300);
+  write_file(dir + "/notes.txt", 10);
+  const std::vector<std::string> all = {a, b, c};
+  const time_t base = time(nullptr) - 3600;
+
+  // First boot: no index, an on_refresh handler queues a file the walk also finds
+  {
+    Fixture fixture(dir, [&](MediaSlideshow &slideshow)
+                    { slideshow.enqueue({a}); });
+    CHECK(fixture.slideshow.sources() == all);
+  }
+
+  // Power lost mid-save on FAT: the old index is gone, the new one is still
+  // the temporary file. It is loaded and put in place.
+  const std::string index_file = dir + "/.slideshow.idx";
+  CHECK(rename(index_file.c_str(), (index_file + ".tmp").c_str()) == 0);
+  {
+    MediaIndex index;
+    index.set_directory(dir);
+    CHECK(index.load());
+    CHECK(index.entries().size() == all.size());
+    CHECK(access(index_file.c_str(), F_OK) == 0);
+    CHECK(access((index_file + ".tmp").c_str(), F_OK) != 0);
+  }
+
+  // Next boot: the saved index is queued right away, the walk adds nothing twice
+  {
+    Fixture fixture(dir);
+    CHECK(fixture.slideshow.sources() == all);
+    fixture.revalidate();
+    CHECK(fixture.slideshow.sources() == all);
+
+    // A deleted file leaves the queue, and the index
+    remove(b.c_str());
+    fixture.revalidate();
+    CHECK(fixture.slideshow.sources() == std::vector<std::string>({a, c}));
+    CHECK(fixture.entry("b.jpg") == nullptr);
+    CHECK(fixture.slideshow.get_media_index()->get_removed() == std::vector<std::string>({b}));
+
+    // A new one is appended
+    write_file(b, 250);
+    fixture.revalidate();
+    CHECK(fixture.slideshow.sources() == all);
+    CHECK(fixture.entry("b.jpg") != nullptr && fixture.entry("b.jpg")->size == 250);
+
+    // Rewriting a file in place leaves the directory's mtime alone; the
+    // file is still compared on the next walk
+    time_t unchanged = get_mtime(dir);
+    write_file(b, 260);
+    set_mtime(dir, unchanged);
+    fixture.revalidate();
+    CHECK(fixture.entry("b.jpg")->size == 260);
+
+    // Only the content changed: the file keeps its place in the queue
+    set_mtime(c, base);
+    fixture.revalidate();
+    CHECK(fixture.entry("c.png")->mtime == static_cast<uint32_t>(base));
+    CHECK(fixture.slideshow.sources() == all);
+
+    remove(c.c_str());
+    fixture.revalidate();
+    CHECK(fixture.slideshow.sources() == std::vector<std::string>({a, b}));
+
+    // A walk does not start a step once the iteration's budget is spent
+    fixture.slideshow.set_loop_budget(1);
+    testing::set_clock_step(10);
+    CHECK(testing::fire_interval(&fixture.slideshow, "refresh"));
+    testing::run_loop(&fixture.slideshow);
+    CHECK(fixture.slideshow.get_media_index()->is_revalidating());
+    testing::set_clock_step(0);
+    fixture.slideshow.set_loop_budget(0);
+    testing::run_loop(&fixture.slideshow);
+    CHECK(!fixture.slideshow.get_media_index()->is_revalidating());
+  }
+
+  // The walk at boot compares the indexed files too
+  write_file(a, 175);
+  {
+    Fixture fixture(dir);
+    CHECK(fixture.slideshow.sources() == std::vector<std::string>({a, b}));
+    CHECK(fixture.entry("a.jpg")->size == 175);
+  }
+
+  remove(a.c_str());
+  remove(b.c_str());
+  remove((dir + "/notes.txt").c_str());
+  remove(index_file.c_str());
+  rmdir(dir.c_str());
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Every queue edit is counted in a page, so trimming drops whole pages
+
+#include "harness.h"
+#include "slideshow.h"
+
+#include <numeric>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 3;
+
+// Exposes the page bookkeeping
+class PagedSlideshow : public SlideshowComponent
+{
+public:
+  std::vector<size_t> pages() const { return {this->page_lengths_.begin(), this->page_lengths_.end()}; }
+  const std::string &source(size_t index) const { return this->queue_[index].source; }
+
+  // The pages account for every item in the queue
+  bool pages_cover_queue() const
+  {
+    return std::accumulate(this->page_lengths_.begin(), this->page_lengths_.end(), size_t(0)) == this->queue_.size();
+  }
+};
+
+struct Fixture
+{
+  Fixture()
+  {
+    StandInServer::get().reset();
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &image : images)
+      slideshow.add_image_slot(&image);
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(0);
+    slideshow.set_page_size(3);
+    slideshow.set_page_watermark(1);
+    slideshow.set_max_resident_pages(2);
+    slideshow.setup();
+  }
+
+  online_image::OnlineImage images[SLOTS];
+  PagedSlideshow slideshow;
+};
+
+static std::vector<std::string> page(const char *prefix)
+{
+  std::vector<std::string> items;
+  for (const char *suffix : {"1", "2", "3"})
+    items.push_back(std::string("http://") + prefix + suffix);
+  return items;
+}
+
+// Items enqueued between pages are trimmed with the page they joined
+static void test_enqueue_joins_newest_page()
+{
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+
+  slideshow.append_page(page("a"), "1");
+  slideshow.enqueue({"http://x"});
+  CHECK(slideshow.pages() == std::vector<size_t>({4}));
+  slideshow.append_page(page("b"), "2");
+  CHECK(slideshow.pages() == std::vector<size_t>({4, 3}));
+
+  slideshow.jump_to(6);
+  slideshow.append_page(page("c"), "3");
+  CHECK(slideshow.pages() == std::vector<size_t>({3, 3}));
+  CHECK(slideshow.pages_cover_queue());
+  CHECK(slideshow.source(0) == "http://b1");
+  CHECK(slideshow.source(slideshow.current_index()) == "http://b3");
+}
+
+// Items before the first page, insertions and removals all stay counted
+static void test_edits_stay_counted()
+{
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+
+  slideshow.enqueue({"http://x", "http://y"});
+  CHECK(slideshow.pages() == std::vector<size_t>({2}));
+  slideshow.append_page(page("a"), "1");
+  slideshow.insert(3, {"http://z"});
+  CHECK(slideshow.pages() == std::vector<size_t>({2, 4}));
+  CHECK(slideshow.remove_item(slideshow.get_item_id(0)));
+  CHECK(slideshow.pages_cover_queue());
+
+  slideshow.clear_queue();
+  CHECK(slideshow.pages().empty());
+  slideshow.enqueue({"http://x"});
+  CHECK(slideshow.pages() == std::vector<size_t>({1}));
+}
+
+// A splice that takes out a whole page keeps the page until trimming
+static void test_splice_keeps_empty_page()
+{
+  Fixture fixture;
+  auto &slideshow = fixture.slideshow;
+
+  slideshow.append_page(page("a"), "1");
+  slideshow.append_page(page("b"), "2");
+  std::vector<uint32_t> b_ids = {slideshow.get_item_id(3), slideshow.get_item_id(4), slideshow.get_item_id(5)};
+
+  // Already in place, or not in the queue: nothing changes, nobody is told
+  size_t updates = 0;
+  slideshow.add_on_queue_updated_callback([&updates](size_t)
+                                          { updates++; });
+  CHECK(!slideshow.splice(b_ids, 3));
+  CHECK(!slideshow.splice({b_ids[0], b_ids[1]}, 4));
+  CHECK(!slideshow.splice({12345}, 0));
+  CHECK(updates == 0);
+
+  // Reversed in place: the items go back into their own page
+  CHECK(slideshow.splice({b_ids[2], b_ids[1], b_ids[0]}, 3));
+  CHECK(slideshow.pages() == std::vector<size_t>({3, 3}));
+  CHECK(slideshow.source(3) == "http://b3");
+  CHECK(updates == 1);
+
+  // Moved to the front: the emptied page stays counted as 0 until trimmed
+  CHECK(slideshow.splice(b_ids, 0));
+  CHECK(slideshow.pages() == std::vector<size_t>({6, 0}));
+  slideshow.append_page(page("c"), "3");
+  CHECK(slideshow.pages() == std::vector<size_t>({6, 3}));
+  CHECK(slideshow.pages_cover_queue());
+}
+
+int main()
+{
+  test_enqueue_joins_newest_page();
+  test_edits_stay_counted();
+  test_splice_keeps_empty_page();
+  printf("PASS\n");
+  return 0;
+}
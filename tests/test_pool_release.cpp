@@ -0,0 +1,98 @@
+// A slot released mid-download is not reused before online_image finishes
+
+#include "harness.h"
+#include "slideshow.h"
+#include "slideshow_pool.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 3;
+static const std::vector<std::string> URLS = {"http://a", "http://b", "http://c",
+                                              "http://d", "http://e", "http://f"};
+
+static void setup_slideshow(SlideshowComponent &slideshow, online_image::OnlineImage *images)
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (auto &url : URLS)
+    server.put(url, 1000);
+
+  slideshow.set_slot_count(SLOTS);
+  slideshow.reserve_image_slots(SLOTS);
+  for (size_t i = 0; i < SLOTS; i++)
+    slideshow.add_image_slot(&images[i]);
+  slideshow.set_advance_interval(1);
+  slideshow.set_refresh_interval(0);
+  slideshow.setup();
+  slideshow.enqueue(URLS);
+  testing::run_loop(&slideshow);
+  // Current, next and previous are downloading
+  CHECK(server.in_flight() == SLOTS);
+}
+
+static void settle(SlideshowComponent &slideshow)
+{
+  auto &server = StandInServer::get();
+  do
+  {
+    testing::run_loop(&slideshow);
+  } while (server.serve() > 0);
+  testing::run_loop(&slideshow);
+}
+
+// Jumping away while every slot downloads: new items wait for those downloads
+static void test_released_loads_drain()
+{
+  auto &server = StandInServer::get();
+  online_image::OnlineImage images[SLOTS];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images);
+
+  slideshow.jump_to(3);
+  testing::run_loop(&slideshow);
+  // Starting another download now would be refused as "already being updated"
+  CHECK(server.in_flight() == SLOTS);
+  CHECK(server.requests == SLOTS);
+
+  // Each completion frees one slot for the new window
+  CHECK(server.serve("http://a") == 1);
+  testing::run_loop(&slideshow);
+  CHECK(server.in_flight() == SLOTS);
+  CHECK(server.requests == SLOTS + 1);
+
+  settle(slideshow);
+  CHECK(server.requests == 2 * SLOTS);
+  CHECK(slideshow.get_current_image() != nullptr);
+  for (size_t i = 0; i < SLOTS; i++)
+    CHECK(!slideshow.get_pool()->is_loading(i) && slideshow.get_pool()->get_slot(i)->is_ready());
+}
+
+// Coming back before the downloads finish picks them up again
+static void test_released_loads_adopted()
+{
+  auto &server = StandInServer::get();
+  online_image::OnlineImage images[SLOTS];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images);
+
+  slideshow.jump_to(3);
+  testing::run_loop(&slideshow);
+  slideshow.jump_to(0);
+  testing::run_loop(&slideshow);
+
+  settle(slideshow);
+  CHECK(server.requests == SLOTS);
+  CHECK(slideshow.get_current_image() != nullptr);
+  CHECK(slideshow.get_pool()->get_source(slideshow.get_current_image() - slideshow.get_pool()->get_slot(0)) ==
+        "http://a");
+}
+
+int main()
+{
+  test_released_loads_drain();
+  test_released_loads_adopted();
+  printf("PASS\n");
+  return 0;
+}
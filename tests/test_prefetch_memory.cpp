@@ -0,0 +1,169 @@
+// The lookahead grows with prefetch_memory, and compressed frames fit more of it
+
+#include "harness.h"
+#include "raw_frame_writer.h"
+#include "slideshow.h"
+#include "slideshow_pool.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using namespace raw_frame_writer;
+
+static const size_t SLOTS = 10;
+static const size_t ITEMS = 12;
+static const int WIDTH = 160;
+static const int HEIGHT = 120;
+
+struct Fixture
+{
+  Fixture(bool compressed, size_t prefetch_memory) : frames{}
+  {
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &frame : frames)
+    {
+      frame.reset(new RawFrameImage(image::IMAGE_TYPE_RGB565));
+      frame->set_compressed_residency(compressed);
+      slideshow.add_image_slot(frame.get());
+    }
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(0);
+    slideshow.set_prefetch_memory(prefetch_memory);
+    slideshow.setup();
+  }
+
+  // Run the slideshow and the frame loaders until both are idle
+  void settle()
+  {
+    for (int i = 0; i < 100; i++)
+    {
+      testing::run_loop(&slideshow);
+      bool loading = false;
+      for (auto &frame : frames)
+      {
+        testing::run_loop(frame.get());
+        loading |= frame->is_loading();
+      }
+      if (!loading && !slideshow.is_loop_enabled())
+        return;
+    }
+  }
+
+  size_t loaded_count()
+  {
+    size_t count = 0;
+    for (size_t i = 0; i < SLOTS; i++)
+      count += !slideshow.get_pool()->get_source(i).empty() && slideshow.get_pool()->get_slot(i)->is_ready();
+    return count;
+  }
+
+  size_t resident_bytes()
+  {
+    size_t bytes = 0;
+    for (size_t i = 0; i < SLOTS; i++)
+      bytes += slideshow.get_pool()->get_resident_bytes(i);
+    return bytes;
+  }
+
+  SlideshowComponent slideshow;
+  std::unique_ptr<RawFrameImage> frames[SLOTS];
+};
+
+static std::vector<std::string> write_frames(size_t *payload)
+{
+  // Flat pictures compress well; each one differs so none are shared
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < ITEMS; i++)
+  {
+    auto pixels = to_rgb565(make_photo(WIDTH, HEIGHT, 0));
+    pixels[i] ^= 0xFF;
+    auto file = encode_frame(image::IMAGE_TYPE_RGB565, WIDTH, HEIGHT, pixels, true);
+    *payload = std::max(*payload, file.size() - sizeof(RawFrameHeader));
+    char name[32];
+    snprintf(name, sizeof(name), "test_prefetch_memory_%zu", i);
+    paths.push_back(temp_path(name));
+    write_file(paths.back(), file);
+  }
+  return paths;
+}
+
+int main()
+{
+  const size_t frame = WIDTH * HEIGHT * 2;
+  size_t payload = 0;
+  auto paths = write_frames(&payload);
+  CHECK(payload * 4 < frame);
+
+  // Without a budget only current, next and previous are loaded
+  {
+    Fixture fixture(true, 0);
+    fixture.slideshow.enqueue(paths);
+    fixture.settle();
+    CHECK(fixture.loaded_count() == 3);
+  }
+
+  // Expanded frames: a budget of five frames holds five
+  {
+    Fixture fixture(false, 5 * frame);
+    fixture.slideshow.enqueue(paths);
+    fixture.settle();
+    CHECK(fixture.loaded_count() == 5);
+    CHECK(fixture.resident_bytes() <= 5 * frame);
+  }
+
+  // Held compressed, the same budget holds every slot
+  {
+    Fixture fixture(true, 5 * frame);
+    fixture.slideshow.enqueue(paths);
+    fixture.settle();
+    CHECK(fixture.loaded_count() == SLOTS);
+    CHECK(fixture.resident_bytes() <= 5 * frame);
+
+    // The window moves along with the current item and stays within budget
+    for (int i = 0; i < 3; i++)
+    {
+      CHECK(testing::fire_interval(&fixture.slideshow, "advance"));
+      fixture.settle();
+      // The shown frame is expanded, and counts in full, before anything draws it
+      auto *img = fixture.slideshow.get_slot_for_index(fixture.slideshow.current_index() % ITEMS);
+      CHECK(img != nullptr && img->get_image()->get_data_start() != nullptr);
+      CHECK(fixture.slideshow.get_current_image() == img);
+      CHECK(fixture.loaded_count() == SLOTS);
+      CHECK(fixture.resident_bytes() <= 5 * frame);
+    }
+  }
+
+  // on_advance handlers redraw at once: the new frame is already expanded
+  {
+    Fixture fixture(true, 5 * frame);
+    fixture.slideshow.enqueue(paths);
+    fixture.settle();
+    int expanded = 0;
+    fixture.slideshow.add_on_advance_callback([&](size_t)
+                                              {
+      auto *img = fixture.slideshow.get_current_image();
+      CHECK(img != nullptr && img->get_image()->get_data_start() != nullptr);
+      CHECK(img->get_image()->get_width() == WIDTH);
+      expanded++; });
+
+    CHECK(testing::fire_interval(&fixture.slideshow, "advance"));
+    fixture.slideshow.advance();
+    fixture.slideshow.previous();
+    fixture.slideshow.jump_to(3);
+    fixture.slideshow.remove_item(fixture.slideshow.current_item_id());
+    CHECK(expanded == 5);
+  }
+
+  // A budget the fixed window already exceeds: that window is kept, nothing is added
+  {
+    Fixture fixture(true, payload);
+    fixture.slideshow.enqueue(paths);
+    fixture.settle();
+    CHECK(fixture.loaded_count() == 3);
+  }
+
+  for (auto &path : paths)
+    remove(path.c_str());
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,149 @@
+// BlurHash previews against a floating-point reference decoder
+
+#include "harness.h"
+#include "slideshow_preview.h"
+
+#include <cmath>
+#include <cstring>
+
+using esphome::slideshow::BlurHashDecoder;
+using esphome::slideshow::FrameBuffer;
+
+static const char BASE83[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@[]^_{|}~";
+
+static int decode83(const std::string &s, size_t start, size_t length)
+{
+  int value = 0;
+  for (size_t i = start; i < start + length; i++)
+    value = value * 83 + static_cast<int>(strchr(BASE83, s[i]) - BASE83);
+  return value;
+}
+
+static std::string encode83(int value, int length)
+{
+  std::string out(length, '0');
+  for (int i = length - 1; i >= 0; i--, value /= 83)
+    out[i] = BASE83[value % 83];
+  return out;
+}
+
+static double srgb_to_linear(int value)
+{
+  double v = value / 255.0;
+  return v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4);
+}
+
+static int linear_to_srgb(double v)
+{
+  v = v < 0 ? 0 : (v > 1 ? 1 : v);
+  double s = v <= 0.0031308 ? v * 12.92 : 1.055 * pow(v, 1 / 2.4) - 0.055;
+  return static_cast<int>(s * 255 + 0.5);
+}
+
+// The reference algorithm from blurha.sh, in doubles, as 8 bit RGB
+static std::vector<uint8_t> reference(const std::string &hash, int width, int height)
+{
+  int flag = decode83(hash, 0, 1);
+  int ny = flag / 9 + 1, nx = flag % 9 + 1;
+  double max_ac = (decode83(hash, 1, 1) + 1) / 166.0;
+  std::vector<double> colors(nx * ny * 3);
+  int dc = decode83(hash, 2, 4);
+  colors[0] = srgb_to_linear(dc >> 16);
+  colors[1] = srgb_to_linear((dc >> 8) & 255);
+  colors[2] = srgb_to_linear(dc & 255);
+  for (int i = 1; i < nx * ny; i++)
+  {
+    int v = decode83(hash, 4 + 2 * i, 2);
+    int q[3] = {v / 361, (v / 19) % 19, v % 19};
+    for (int c = 0; c < 3; c++)
+    {
+      double t = (q[c] - 9) / 9.0;
+      colors[i * 3 + c] = copysign(t * t, t) * max_ac;
+    }
+  }
+
+  std::vector<uint8_t> out(width * height * 3);
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+    {
+      double pixel[3] = {0, 0, 0};
+      for (int j = 0; j < ny; j++)
+        for (int i = 0; i < nx; i++)
+        {
+          double basis = cos(M_PI * x * i / width) * cos(M_PI * y * j / height);
+          for (int c = 0; c < 3; c++)
+            pixel[c] += colors[(j * nx + i) * 3 + c] * basis;
+        }
+      for (int c = 0; c < 3; c++)
+        out[(y * width + x) * 3 + c] = linear_to_srgb(pixel[c]);
+    }
+  return out;
+}
+
+// Largest difference to the reference, in 8 bit units after RGB565 quantization
+static int max_error(const std::string &hash, int width, int height, int rows_per_call)
+{
+  FrameBuffer frame;
+  CHECK(frame.allocate(width, height, esphome::image::IMAGE_TYPE_RGB565));
+  BlurHashDecoder decoder;
+  CHECK(decoder.begin(hash, &frame));
+  while (!decoder.decode_rows(rows_per_call))
+  {
+  }
+  CHECK(!decoder.is_decoding());
+
+  std::vector<uint8_t> ref = reference(hash, width, height);
+  int worst = 0;
+  for (int i = 0; i < width * height; i++)
+  {
+    uint16_t p = frame.data()[2 * i] << 8 | frame.data()[2 * i + 1];
+    int got[3] = {(p >> 11) << 3, ((p >> 5) & 63) << 2, (p & 31) << 3};
+    int want[3] = {ref[3 * i] & 0xF8, ref[3 * i + 1] & 0xFC, ref[3 * i + 2] & 0xF8};
+    for (int c = 0; c < 3; c++)
+      worst = std::max(worst, abs(got[c] - want[c]));
+  }
+  return worst;
+}
+
+int main()
+{
+  const std::string hashes[] = {
+      "LEHV6nWB2yk8pyo0adR*.7kCMdnj",
+      "LGF5]+Yk^6#M@-5c,1J5@[or[Q6.",
+      "L6PZfSi_.AyE_3t7t7R**0o#DgR4",
+  };
+
+  // 9x9 components, every AC at the largest positive value: the sums peak
+  // where all cosines are 1, which must not overflow the fixed-point math
+  std::string extreme = "|~" + encode83(0xFFFFFF, 4);
+  for (int i = 1; i < 81; i++)
+    extreme += encode83(18 * 361 + 18 * 19 + 18, 2);
+
+  // Same, all negative, to saturate at black
+  std::string extreme_negative = "|~" + encode83(0, 4);
+  for (int i = 1; i < 81; i++)
+    extreme_negative += encode83(0, 2);
+
+  for (const auto &hash : hashes)
+    CHECK(BlurHashDecoder::is_valid(hash));
+  CHECK(BlurHashDecoder::is_valid(extreme));
+  CHECK(!BlurHashDecoder::is_valid("LEHV6nWB2yk8pyo0adR*.7kCMdn")); // One character short
+  CHECK(!BlurHashDecoder::is_valid("http://example.com/a.jpg"));
+  CHECK(!BlurHashDecoder::is_valid(""));
+
+  FrameBuffer unallocated;
+  BlurHashDecoder decoder;
+  CHECK(!decoder.begin(hashes[0], &unallocated));
+
+  for (const auto &hash : hashes)
+  {
+    // One RGB565 step: 8 for red and blue, 4 for green
+    CHECK(max_error(hash, 200, 120, 16) <= 8);
+    CHECK(max_error(hash, 37, 23, 1) <= 8);
+  }
+  CHECK(max_error(extreme, 160, 96, 7) <= 8);
+  CHECK(max_error(extreme_negative, 160, 96, 7) <= 8);
+
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,200 @@
+// Raw frames load bit-exact from files and HTTP, raw or LZ4, in any chunking
+
+#include "harness.h"
+#include "raw_frame_writer.h"
+#include "slideshow_lz4.h"
+
+#include <cstring>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using namespace raw_frame_writer;
+
+// Decode compressed in chunks of chunk bytes
+static bool lz4_decode(const std::vector<uint8_t> &compressed, std::vector<uint8_t> &out, size_t chunk)
+{
+  Lz4StreamDecoder decoder;
+  decoder.reset(out.data(), out.size());
+  for (size_t pos = 0; pos < compressed.size(); pos += chunk)
+  {
+    if (!decoder.feed(compressed.data() + pos, std::min(chunk, compressed.size() - pos)))
+      return false;
+  }
+  return decoder.is_complete();
+}
+
+static void test_lz4_round_trip()
+{
+  std::vector<std::vector<uint8_t>> inputs;
+  inputs.push_back(to_rgb565(make_photo(320, 240)));
+  inputs.push_back(to_rgb565(make_photo(320, 240, 0)));
+  inputs.push_back(std::vector<uint8_t>(70000, 0x5A)); // Long overlapping matches
+  std::vector<uint8_t> noise(5000);
+  uint32_t seed = 7;
+  for (auto &byte : noise)
+    byte = (seed = seed * 1103515245 + 12345) >> 24; // Literals only
+  inputs.push_back(noise);
+  inputs.push_back({1, 2, 3});
+
+  for (const auto &input : inputs)
+  {
+    auto compressed = lz4_compress(input);
+    for (size_t chunk : {size_t(1), size_t(3), size_t(4096), compressed.size()})
+    {
+      std::vector<uint8_t> out(input.size());
+      CHECK(lz4_decode(compressed, out, chunk));
+      CHECK(out == input);
+    }
+  }
+}
+
+static void test_lz4_rejects_corrupt_blocks()
+{
+  auto input = to_rgb565(make_photo(64, 48));
+  auto compressed = lz4_compress(input);
+
+  // Too short a frame for the block, and a block that stops short of the frame
+  std::vector<uint8_t> small(input.size() - 1);
+  CHECK(!lz4_decode(compressed, small, compressed.size()));
+  std::vector<uint8_t> large(input.size() + 1);
+  CHECK(!lz4_decode(compressed, large, compressed.size()));
+
+  // A match reaching back before the start of the frame, and a zero offset.
+  // Padded so they are checked both a byte at a time and as whole sequences.
+  for (uint8_t offset : {2, 0})
+  {
+    std::vector<uint8_t> block = {0x10, 'a', offset, 0x00};
+    block.resize(24, 0x00);
+    std::vector<uint8_t> out(64);
+    CHECK(!lz4_decode(block, out, 1));
+    CHECK(!lz4_decode(block, out, block.size()));
+  }
+}
+
+// A frame image and the outcome of its loads
+struct Loader
+{
+  explicit Loader(image::ImageType type) : img(type)
+  {
+    this->img.add_on_finished_callback([this](bool cached)
+                                       { this->finished++; });
+    this->img.add_on_error_callback([this]()
+                                    { this->errors++; });
+  }
+  Loader(const Loader &) = delete;
+
+  void load(const std::string &source)
+  {
+    this->img.set_source(source);
+    this->img.update();
+    testing::run_loop(&this->img, 1000);
+    CHECK(!this->img.is_loading());
+  }
+
+  RawFrameImage img;
+  int finished{0};
+  int errors{0};
+};
+
+static bool has_pixels(RawFrameImage &img, int width, int height, const std::vector<uint8_t> &pixels)
+{
+  return img.get_width() == width && img.get_height() == height && img.get_data_start() != nullptr &&
+         memcmp(img.get_data_start(), pixels.data(), pixels.size()) == 0;
+}
+
+static void test_load(bool lz4, bool http)
+{
+  auto pixels = to_rgb565(make_photo(200, 150));
+  auto path = temp_path("test_raw_frame");
+  write_file(path, encode_frame(image::IMAGE_TYPE_RGB565, 200, 150, pixels, lz4));
+
+  http_request::HttpRequestComponent server;
+  Loader loader(image::IMAGE_TYPE_RGB565);
+  auto &img = loader.img;
+  img.set_http_request(&server);
+  img.set_time_budget(100); // Several loop() calls per frame
+  loader.load(http ? "http://frames.local" + path : path);
+  CHECK(loader.finished == 1 && loader.errors == 0);
+  CHECK(has_pixels(img, 200, 150, pixels));
+  CHECK(img.get_resident_bytes() == pixels.size());
+
+  img.release();
+  CHECK(img.get_data_start() == nullptr);
+  CHECK(img.get_resident_bytes() == 0);
+  remove(path.c_str());
+}
+
+// Prefetched LZ4 frames stay compressed and are expanded only while displayed
+static void test_compressed_residency()
+{
+  auto pixels = to_rgb565(make_photo(200, 150));
+  auto file = encode_frame(image::IMAGE_TYPE_RGB565, 200, 150, pixels, true);
+  size_t payload = file.size() - sizeof(RawFrameHeader);
+  auto path = temp_path("test_raw_frame");
+  write_file(path, file);
+
+  Loader loader(image::IMAGE_TYPE_RGB565);
+  auto &img = loader.img;
+  img.set_compressed_residency(true);
+  loader.load(path);
+  CHECK(loader.finished == 1 && loader.errors == 0);
+  CHECK(img.get_data_start() == nullptr);
+  CHECK(img.get_resident_bytes() == payload);
+
+  img.set_displayed(true);
+  CHECK(has_pixels(img, 200, 150, pixels));
+  CHECK(img.get_resident_bytes() == payload + pixels.size());
+
+  img.set_displayed(false);
+  CHECK(img.get_data_start() == nullptr);
+  CHECK(img.get_resident_bytes() == payload);
+
+  // A frame that finishes loading while displayed is expanded at once
+  img.set_displayed(true);
+  loader.load(path);
+  CHECK(loader.finished == 2);
+  CHECK(has_pixels(img, 200, 150, pixels));
+  remove(path.c_str());
+}
+
+static void test_bad_frames_fail()
+{
+  auto pixels = to_rgb565(make_photo(40, 30));
+  auto file = encode_frame(image::IMAGE_TYPE_RGB565, 40, 30, pixels, false);
+  auto path = temp_path("test_raw_frame");
+
+  // Truncated payload
+  write_file(path, std::vector<uint8_t>(file.begin(), file.end() - 10));
+  Loader truncated(image::IMAGE_TYPE_RGB565);
+  truncated.load(path);
+  CHECK(truncated.finished == 0 && truncated.errors == 1);
+
+  // A grayscale slot cannot take an RGB565 frame
+  write_file(path, file);
+  Loader gray(image::IMAGE_TYPE_GRAYSCALE);
+  gray.load(path);
+  CHECK(gray.finished == 0 && gray.errors == 1);
+
+  // Not a frame, and no file at all
+  write_file(path, std::vector<uint8_t>(64, 'x'));
+  Loader other(image::IMAGE_TYPE_RGB565);
+  other.load(path);
+  CHECK(other.finished == 0 && other.errors == 1);
+  remove(path.c_str());
+  other.load(path);
+  CHECK(other.errors == 2);
+}
+
+int main()
+{
+  test_lz4_round_trip();
+  test_lz4_rejects_corrupt_blocks();
+  test_load(false, false);
+  test_load(true, false);
+  test_load(false, true);
+  test_load(true, true);
+  test_compressed_residency();
+  test_bad_frames_fail();
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,93 @@
+// FrameResampler against a double precision reference of the same filter
+
+#include "harness.h"
+#include "resample_reference.h"
+
+using namespace esphome::slideshow;
+using esphome::image::ImageType;
+
+struct Quality
+{
+  int max_error; // 8 bit units after RGB565 quantization
+  double psnr;   // Against the unquantized reference
+};
+
+static Quality check(int src_w, int src_h, ImageType type, int dst_w, int dst_h, FitMode mode, int rows_per_call)
+{
+  auto src = resample_reference::make_source(src_w, src_h, type);
+  esphome::image::Image img(src.pixels.data(), src_w, src_h, type, esphome::image::TRANSPARENCY_OPAQUE);
+  FrameBuffer frame;
+  CHECK(frame.allocate(dst_w, dst_h, esphome::image::IMAGE_TYPE_RGB565));
+  memset(frame.data(), 0xA5, frame.size()); // Bars must be written, not left over
+
+  FrameResampler resampler;
+  CHECK(resampler.begin(&img, &frame, mode));
+  CHECK(resampler.get_source_data() == src.pixels.data());
+  while (!resampler.resample_rows(rows_per_call))
+  {
+  }
+  CHECK(!resampler.is_resampling());
+
+  std::vector<double> ref = resample_reference::fit(src, dst_w, dst_h, mode);
+  Quality q{0, 0};
+  double squared = 0;
+  for (size_t i = 0; i < static_cast<size_t>(dst_w) * dst_h; i++)
+  {
+    uint16_t p = frame.data()[2 * i] << 8 | frame.data()[2 * i + 1];
+    int got[3] = {(p >> 11) << 3, ((p >> 5) & 63) << 2, (p & 31) << 3};
+    int masks[3] = {0xF8, 0xFC, 0xF8};
+    for (int c = 0; c < 3; c++)
+    {
+      double want = ref[i * 3 + c];
+      q.max_error = std::max(q.max_error, abs(got[c] - (static_cast<int>(lround(want)) & masks[c])));
+      squared += (got[c] - want) * (got[c] - want);
+    }
+  }
+  q.psnr = 10 * log10(255.0 * 255.0 / (squared / (dst_w * dst_h * 3.0)));
+  return q;
+}
+
+int main()
+{
+  struct Case
+  {
+    int src_w, src_h;
+    ImageType type;
+    int dst_w, dst_h;
+    FitMode mode;
+  };
+  const Case cases[] = {
+      {400, 300, esphome::image::IMAGE_TYPE_RGB565, 200, 120, FIT_MODE_COVER},       // Shrink, crop top and bottom
+      {256, 192, esphome::image::IMAGE_TYPE_RGB, 200, 120, FIT_MODE_CONTAIN},        // Shrink, bars left and right
+      {160, 120, esphome::image::IMAGE_TYPE_RGB565, 200, 120, FIT_MODE_COVER},       // Enlarge
+      {120, 200, esphome::image::IMAGE_TYPE_GRAYSCALE, 200, 120, FIT_MODE_CONTAIN},  // Portrait on landscape
+      {250, 175, esphome::image::IMAGE_TYPE_GRAYSCALE, 200, 120, FIT_MODE_CENTER_CROP},
+      {75, 50, esphome::image::IMAGE_TYPE_RGB565, 200, 120, FIT_MODE_CENTER_CROP},   // Padded on all sides
+      {1000, 750, esphome::image::IMAGE_TYPE_RGB565, 120, 80, FIT_MODE_COVER},       // Wide filter
+      {1, 1, esphome::image::IMAGE_TYPE_RGB, 33, 17, FIT_MODE_CONTAIN},
+  };
+
+  for (const auto &c : cases)
+  {
+    Quality q = check(c.src_w, c.src_h, c.type, c.dst_w, c.dst_h, c.mode, 7);
+    printf("%4dx%-4d type %d -> %dx%d mode %d: max error %d, %.1f dB\n", c.src_w, c.src_h, c.type, c.dst_w, c.dst_h,
+           c.mode, q.max_error, q.psnr);
+    // Within one RGB565 step of the reference; the PSNR is bounded by RGB565 itself
+    CHECK(q.max_error <= 8);
+    CHECK(q.psnr >= 35.0);
+  }
+
+  // Unsupported sources are refused, so the caller shows them unscaled
+  std::vector<uint8_t> pixels(16 * 16 * 4);
+  esphome::image::Image transparent(pixels.data(), 16, 16, esphome::image::IMAGE_TYPE_RGB565,
+                                    esphome::image::TRANSPARENCY_ALPHA_CHANNEL);
+  esphome::image::Image binary(pixels.data(), 16, 16, esphome::image::IMAGE_TYPE_BINARY,
+                               esphome::image::TRANSPARENCY_OPAQUE);
+  esphome::image::Image unloaded(nullptr, 0, 0, esphome::image::IMAGE_TYPE_RGB565, esphome::image::TRANSPARENCY_OPAQUE);
+  CHECK(!FrameResampler::supports(&transparent));
+  CHECK(!FrameResampler::supports(&binary));
+  CHECK(!FrameResampler::supports(&unloaded));
+
+  printf("PASS\n");
+  return 0;
+}
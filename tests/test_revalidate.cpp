@@ -0,0 +1,176 @@
+// Held frames are revalidated with conditional requests instead of downloaded
+// again. The pool keeps the validators by source and sends them only for the
+// frame it holds; the stand-in online_image just sends what it is given.
+
+#include "harness.h"
+#include "slideshow.h"
+#include "slideshow_pool.h"
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t BODY_BYTES = 5000;
+
+static void setup_slideshow(SlideshowComponent &slideshow, online_image::OnlineImage *images, size_t count,
+                            bool revalidate)
+{
+  slideshow.set_slot_count(count);
+  slideshow.reserve_image_slots(count);
+  for (size_t i = 0; i < count; i++)
+    slideshow.add_image_slot(&images[i]);
+  slideshow.set_advance_interval(1);
+  slideshow.set_refresh_interval(0);
+  slideshow.set_revalidate(revalidate);
+  slideshow.setup();
+}
+
+static void settle(SlideshowComponent &slideshow)
+{
+  auto &server = StandInServer::get();
+  do
+  {
+    testing::run_loop(&slideshow);
+  } while (server.serve() > 0);
+  testing::run_loop(&slideshow);
+}
+
+// Advance once around a queue of count items, answering every load
+static void play_lap(SlideshowComponent &slideshow, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    CHECK(testing::fire_interval(&slideshow, "advance"));
+    settle(slideshow);
+  }
+}
+
+static const std::vector<std::string> URLS = {"http://a", "http://b", "http://c", "http://d", "http://e"};
+
+// Bytes downloaded for the second lap of a queue that fits in the slots
+static size_t second_lap_bytes(bool revalidate, size_t *not_modified)
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (auto &url : URLS)
+    server.put(url, BODY_BYTES);
+
+  online_image::OnlineImage images[5];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 5, revalidate);
+  slideshow.enqueue(URLS);
+  settle(slideshow);
+  play_lap(slideshow, URLS.size());
+  CHECK(slideshow.current_index() % URLS.size() == 0);
+
+  size_t before = server.bytes_served;
+  size_t not_modified_before = server.not_modified;
+  play_lap(slideshow, URLS.size());
+  CHECK(slideshow.get_stats().image_errors == 0);
+  *not_modified = server.not_modified - not_modified_before;
+  return server.bytes_served - before;
+}
+
+static void test_second_lap_is_not_downloaded()
+{
+  size_t not_modified;
+  size_t without = second_lap_bytes(false, &not_modified);
+  CHECK(not_modified == 0);
+  // Only the prev/current/next window stays loaded, so every advance downloads an item
+  CHECK(without == URLS.size() * BODY_BYTES);
+
+  size_t with = second_lap_bytes(true, &not_modified);
+  CHECK(with == 0);
+  CHECK(not_modified == URLS.size());
+  printf("Second lap: %zu bytes without revalidation, %zu with (%zu answered 304)\n", without, with, not_modified);
+}
+
+// A changed body gets a new ETag, so only that item is downloaded again
+static void test_changed_item_is_downloaded()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (auto &url : URLS)
+    server.put(url, BODY_BYTES);
+
+  online_image::OnlineImage images[5];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 5, true);
+  slideshow.enqueue(URLS);
+  settle(slideshow);
+  play_lap(slideshow, URLS.size());
+
+  server.put("http://c", 2 * BODY_BYTES);
+  size_t before = server.bytes_served;
+  play_lap(slideshow, URLS.size());
+  CHECK(server.bytes_served - before == 2 * BODY_BYTES);
+  CHECK(slideshow.get_pool()->get_revalidation_hits() > 0);
+
+  // The pool took the new ETag from the full response
+  for (auto &url : URLS)
+  {
+    const HttpValidators *validators = slideshow.get_pool()->get_validators(url);
+    CHECK(validators != nullptr && validators->etag == server.etag(url));
+  }
+}
+
+// The validators sent come from the pool, not from what the image kept
+static void test_validators_come_from_the_pool()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (auto &url : URLS)
+    server.put(url, BODY_BYTES);
+
+  online_image::OnlineImage images[5];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 5, true);
+  slideshow.enqueue(URLS);
+  settle(slideshow);
+  play_lap(slideshow, URLS.size());
+
+  for (auto &image : images)
+    OnlineImageValidators::etag(&image).clear();
+  size_t before = server.bytes_served;
+  play_lap(slideshow, URLS.size());
+  CHECK(server.bytes_served == before);
+}
+
+// A source's validators never go out with another source, even when the
+// image kept them: a slot whose revalidation failed still has its old ETag
+static void test_validators_stay_with_their_source()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (auto &url : URLS)
+    server.put(url, BODY_BYTES);
+
+  online_image::OnlineImage images[5];
+  SlideshowComponent slideshow;
+  setup_slideshow(slideshow, images, 5, true);
+  slideshow.enqueue(URLS);
+  settle(slideshow);
+  play_lap(slideshow, URLS.size());
+
+  server.remove("http://c");
+  play_lap(slideshow, URLS.size());
+  auto *pool = slideshow.get_pool();
+  CHECK(pool->get_validators("http://c") == nullptr);
+
+  server.put("http://f", BODY_BYTES);
+  slideshow.enqueue({"http://f"});
+  play_lap(slideshow, URLS.size() + 1);
+  CHECK(pool->get_validators("http://f") != nullptr && pool->get_validators("http://f")->etag == server.etag("http://f"));
+  // Only revalidations were conditional
+  CHECK(server.conditional == pool->get_revalidations());
+}
+
+int main()
+{
+  test_second_lap_is_not_downloaded();
+  test_changed_item_is_downloaded();
+  test_validators_come_from_the_pool();
+  test_validators_stay_with_their_source();
+  printf("PASS\n");
+  return 0;
+}
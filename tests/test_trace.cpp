@@ -0,0 +1,163 @@
+// Event trace: the ring buffer wraps, the file has the layout
+// tools/slideshow_trace.py reads, and counts saturate in the 16-bit flags
+
+#include "harness.h"
+#include "slideshow.h"
+#include "slideshow_trace.h"
+
+#include "esphome/core/helpers.h"
+
+#include <unistd.h>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static_assert(sizeof(TraceEvent) == 12, "tools/slideshow_trace.py reads 12-byte events");
+
+// Little endian, as struct.Struct("<...") in the tool
+static uint32_t u32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24; }
+static uint16_t u16(const uint8_t *p) { return p[0] | p[1] << 8; }
+
+// The oldest events are overwritten once full, and counted as dropped
+static void test_wraparound()
+{
+  TraceRecorder trace(4);
+  for (uint32_t i = 1; i <= 6; i++)
+    trace.record(i * 10, TRACE_ADVANCE, TRACE_NO_SLOT, i, 0x1000 + i);
+  CHECK(trace.size() == 4);
+  CHECK(trace.capacity() == 4);
+  CHECK(trace.dropped() == 2);
+  for (size_t i = 0; i < 4; i++)
+  {
+    CHECK(trace.at(i).timestamp == (i + 3) * 10);
+    CHECK(trace.at(i).flags == i + 3);
+  }
+
+  trace.clear();
+  CHECK(trace.size() == 0 && trace.dropped() == 0);
+  trace.record(70, TRACE_ERROR, 2, 0, 0);
+  CHECK(trace.size() == 1 && trace.at(0).timestamp == 70);
+
+  // Tracing disabled
+  TraceRecorder none(0);
+  none.record(1, TRACE_ADVANCE, TRACE_NO_SLOT, 0, 0);
+  CHECK(none.size() == 0);
+}
+
+// Header (magic, version, count, dropped), then "<IBBHI" events oldest first
+static void test_file_layout()
+{
+  TraceRecorder trace(3);
+  trace.record(100, TRACE_ENQUEUE, TRACE_NO_SLOT, 5, 5);
+  trace.record(200, TRACE_LOAD_START, 1, TRACE_FLAG_REVALIDATE, 0xAABBCCDD);
+  trace.record(300, TRACE_READY, 1, TRACE_FLAG_CACHED, 1536);
+  trace.record(400, TRACE_ADVANCE, TRACE_NO_SLOT, 1, 0x01020304);
+
+  char path[64];
+  snprintf(path, sizeof(path), "/tmp/test_trace_%d.bin", static_cast<int>(getpid()));
+  FILE *file = fopen(path, "wb");
+  CHECK(file != nullptr);
+  CHECK(trace.write_to(file));
+  fclose(file);
+
+  uint8_t data[256];
+  file = fopen(path, "rb");
+  CHECK(file != nullptr);
+  size_t size = fread(data, 1, sizeof(data), file);
+  fclose(file);
+  remove(path);
+
+  CHECK(size == 16 + 3 * 12);
+  CHECK(u32(data) == 0x52545353); // "SSTR"
+  CHECK(u32(data + 4) == TRACE_FILE_VERSION);
+  CHECK(u32(data + 8) == 3);
+  CHECK(u32(data + 12) == 1);
+
+  const uint8_t *event = data + 16;
+  CHECK(u32(event) == 200 && event[4] == TRACE_LOAD_START && event[5] == 1);
+  CHECK(u16(event + 6) == TRACE_FLAG_REVALIDATE && u32(event + 8) == 0xAABBCCDD);
+  event += 12;
+  CHECK(u32(event) == 300 && event[4] == TRACE_READY && u16(event + 6) == TRACE_FLAG_CACHED);
+  CHECK(u32(event + 8) == 1536);
+  event += 12;
+  CHECK(u32(event) == 400 && event[4] == TRACE_ADVANCE && event[5] == TRACE_NO_SLOT);
+  CHECK(u16(event + 6) == 1 && u32(event + 8) == 0x01020304);
+}
+
+static const TraceEvent *last_event(TraceRecorder *trace, TraceEventType type)
+{
+  for (size_t i = trace->size(); i > 0; i--)
+  {
+    if (trace->at(i - 1).type == type)
+      return &trace->at(i - 1);
+  }
+  return nullptr;
+}
+
+// What the slideshow records: counts saturate, loads are keyed like navigation
+static void test_slideshow_events()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  static const size_t SLOTS = 3;
+  online_image::OnlineImage images[SLOTS];
+  SlideshowComponent slideshow;
+  slideshow.set_slot_count(SLOTS);
+  slideshow.reserve_image_slots(SLOTS);
+  for (auto &image : images)
+    slideshow.add_image_slot(&image);
+  slideshow.set_advance_interval(1);
+  slideshow.set_refresh_interval(0);
+  slideshow.set_trace_size(64);
+  slideshow.setup();
+  auto *trace = slideshow.get_trace();
+  CHECK(trace != nullptr);
+
+  // More items than the flags can count
+  std::vector<std::string> urls;
+  for (size_t i = 0; i < 70000; i++)
+  {
+    urls.push_back("http://" + std::to_string(i));
+  }
+  for (auto url : {"http://0", "http://x", "http://69999"})
+    server.put(url, 1000);
+  slideshow.enqueue(urls);
+  const TraceEvent *enqueued = last_event(trace, TRACE_ENQUEUE);
+  CHECK(enqueued != nullptr && enqueued->flags == 0xFFFF && enqueued->arg == 70000);
+
+  // Inserting records how many were added, not the queue size
+  slideshow.insert(1, {"http://x", "http://y"});
+  enqueued = last_event(trace, TRACE_ENQUEUE);
+  CHECK(enqueued->flags == 2 && enqueued->arg == 70002);
+
+  do
+  {
+    testing::run_loop(&slideshow);
+  } while (server.serve() > 0);
+
+  const TraceEvent *started = last_event(trace, TRACE_LOAD_START);
+  const TraceEvent *ready = last_event(trace, TRACE_READY);
+  CHECK(started != nullptr && started->slot < SLOTS);
+  CHECK(ready != nullptr && ready->arg > 0);
+
+  // The current item's load and the jump to it carry the same hash
+  slideshow.jump_to(69999);
+  // Copied: later events may take its place in the ring
+  TraceEvent jumped = *last_event(trace, TRACE_JUMP_TO);
+  CHECK(jumped.flags == 0xFFFF && jumped.arg == fnv1_hash("http://69997"));
+  testing::run_loop(&slideshow);
+  bool loaded = false;
+  for (size_t i = 0; i < trace->size(); i++)
+    loaded |= trace->at(i).type == TRACE_LOAD_START && trace->at(i).arg == jumped.arg;
+  CHECK(loaded);
+}
+
+int main()
+{
+  test_wraparound();
+  test_file_layout();
+  test_slideshow_events();
+  printf("PASS\n");
+  return 0;
+}
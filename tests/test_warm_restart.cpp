@@ -0,0 +1,210 @@
+// Warm restart: the frame cache survives aborted and interrupted writes and
+// ignores a truncated file, and a rebooted slideshow finds its position again
+// and shows the cached frame until the first download
+
+#include "harness.h"
+#include "slideshow.h"
+#include "slideshow_frame_cache.h"
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace esphome;
+using namespace esphome::slideshow;
+using esphome::testing::StandInServer;
+
+static const size_t SLOTS = 3;
+static const std::vector<std::string> URLS = {"http://a", "http://b", "http://c", "http://d", "http://e"};
+
+static std::string temp_path(const char *name)
+{
+  char path[64];
+  snprintf(path, sizeof(path), "/tmp/test_warm_restart_%d_%s", static_cast<int>(getpid()), name);
+  return path;
+}
+
+static bool exists(const std::string &path) { return access(path.c_str(), F_OK) == 0; }
+
+static void truncate_to_half(const std::string &path)
+{
+  FILE *file = fopen(path.c_str(), "rb");
+  CHECK(file != nullptr);
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fclose(file);
+  CHECK(truncate(path.c_str(), size / 2) == 0);
+}
+
+// A frame whose bytes depend on seed
+static void fill_frame(FrameBuffer &frame, uint8_t seed)
+{
+  CHECK(frame.allocate(40, 30, image::IMAGE_TYPE_RGB565));
+  for (size_t i = 0; i < frame.size(); i++)
+    frame.data()[i] = static_cast<uint8_t>(i * 7 + seed);
+}
+
+static void write_frame(FrameCache &cache, FrameBuffer &frame, uint32_t hash)
+{
+  CHECK(cache.begin_write(frame.get_image(), hash));
+  // Several steps, the last one short
+  size_t steps = 1;
+  while (!cache.write_step(1000))
+    steps++;
+  CHECK(steps == (frame.size() + 999) / 1000);
+  CHECK(!cache.is_writing());
+}
+
+static void test_frame_cache()
+{
+  const std::string path = temp_path("frame");
+  FrameCache cache;
+  cache.set_path(path);
+  FrameBuffer first, second, restored;
+  fill_frame(first, 1);
+  fill_frame(second, 2);
+
+  // Nothing cached yet
+  CHECK(cache.read(restored) == 0 && !restored.is_allocated());
+
+  write_frame(cache, first, 0x1111);
+  CHECK(cache.get_cached_hash() == 0x1111);
+  CHECK(!exists(path + ".tmp"));
+  CHECK(cache.read(restored) == 0x1111);
+  CHECK(restored.size() == first.size() && memcmp(restored.data(), first.data(), first.size()) == 0);
+
+  // An aborted write leaves the cached frame alone
+  CHECK(cache.begin_write(second.get_image(), 0x2222));
+  CHECK(!cache.write_step(1000));
+  cache.abort_write();
+  CHECK(!cache.is_writing() && !exists(path + ".tmp"));
+  CHECK(cache.get_cached_hash() == 0x1111);
+  CHECK(cache.read(restored) == 0x1111 && memcmp(restored.data(), first.data(), first.size()) == 0);
+
+  // A completed write replaces it
+  write_frame(cache, second, 0x2222);
+  CHECK(cache.read(restored) == 0x2222 && memcmp(restored.data(), second.data(), second.size()) == 0);
+
+  // Power lost on FAT between removing the old file and the rename: the
+  // complete temporary file is read and put in place
+  CHECK(rename(path.c_str(), (path + ".tmp").c_str()) == 0);
+  CHECK(cache.read(restored) == 0x2222 && memcmp(restored.data(), second.data(), second.size()) == 0);
+  CHECK(exists(path) && !exists(path + ".tmp"));
+
+  // A truncated file is ignored, whether in place or temporary
+  truncate_to_half(path);
+  CHECK(cache.read(restored) == 0 && !restored.is_allocated());
+  CHECK(rename(path.c_str(), (path + ".tmp").c_str()) == 0);
+  CHECK(cache.read(restored) == 0 && !restored.is_allocated());
+  remove((path + ".tmp").c_str());
+}
+
+// Exposes the current item's source
+class WarmSlideshow : public SlideshowComponent
+{
+public:
+  const std::string &current_source() const { return this->queue_[this->current_index_ % this->queue_.size()].source; }
+};
+
+// One boot: a slideshow set up with the same key and cache as the last one
+struct Boot
+{
+  Boot(const std::string &frame_cache)
+  {
+    slideshow.set_slot_count(SLOTS);
+    slideshow.reserve_image_slots(SLOTS);
+    for (auto &image : images)
+      slideshow.add_image_slot(&image);
+    slideshow.set_advance_interval(1);
+    slideshow.set_refresh_interval(0);
+    slideshow.set_restore_key("living_room");
+    slideshow.set_frame_cache_path(frame_cache);
+    slideshow.setup();
+  }
+
+  void settle()
+  {
+    auto &server = StandInServer::get();
+    do
+    {
+      testing::run_loop(&slideshow);
+    } while (server.serve() > 0);
+    testing::run_loop(&slideshow);
+  }
+
+  online_image::OnlineImage images[SLOTS];
+  WarmSlideshow slideshow;
+};
+
+static void test_warm_restart()
+{
+  auto &server = StandInServer::get();
+  server.reset();
+  for (auto &url : URLS)
+    server.put(url, 1000);
+  global_preferences->reset();
+  const std::string frame_cache = temp_path("warm");
+  remove(frame_cache.c_str());
+
+  // First boot: nothing to restore. The position is saved on navigation,
+  // the frame once it has stayed on screen.
+  {
+    Boot boot(frame_cache);
+    CHECK(boot.slideshow.get_current_image() == nullptr);
+    boot.slideshow.enqueue(URLS);
+    boot.settle();
+    CHECK(boot.slideshow.current_index() == 0);
+    boot.slideshow.jump_to(3);
+    boot.settle();
+    CHECK(testing::fire_timeout(&boot.slideshow, "frame_cache"));
+    testing::run_loop(&boot.slideshow);
+    CHECK(exists(frame_cache));
+  }
+
+  // Same queue: the index is restored directly, and the cached frame stands
+  // in for the current item until it is downloaded again
+  {
+    Boot boot(frame_cache);
+    auto *warm = boot.slideshow.get_current_image();
+    CHECK(warm != nullptr && warm->is_ready() && warm->get_image()->get_width() == 32);
+    boot.slideshow.enqueue(URLS);
+    CHECK(boot.slideshow.current_index() == 3);
+    CHECK(boot.slideshow.get_current_image() == warm);
+    boot.settle();
+    CHECK(boot.slideshow.get_current_image() != warm);
+    CHECK(boot.slideshow.get_current_image()->is_ready());
+  }
+
+  // A rebuilt queue in which the item moved: it is searched for
+  {
+    Boot boot(frame_cache);
+    boot.slideshow.enqueue({"http://e", "http://a", "http://b", "http://c", "http://d"});
+    boot.settle();
+    CHECK(boot.slideshow.current_source() == "http://d");
+    CHECK(boot.slideshow.current_index() == 4);
+  }
+
+  // A truncated frame cache shows nothing, the position is still restored
+  truncate_to_half(frame_cache);
+  {
+    Boot boot(frame_cache);
+    CHECK(boot.slideshow.get_current_image() == nullptr);
+    boot.slideshow.enqueue({"http://e", "http://a", "http://b", "http://c", "http://d"});
+    boot.settle();
+    CHECK(boot.slideshow.current_source() == "http://d");
+  }
+
+  remove(frame_cache.c_str());
+  remove((frame_cache + ".tmp").c_str());
+}
+
+int main()
+{
+  test_frame_cache();
+  test_warm_restart();
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""Convert images to the slideshow's pre-decoded raw frame format.
+
+Raw frames skip JPEG/PNG decoding on the device: the payload streams straight
+into the frame buffer of a `raw_frame_slots` slot. Convert on the server, at
+the panel's exact resolution and pixel type:
+
+    slideshow_frame.py convert photo.jpg photo.ssrf --size 800x480
+    slideshow_frame.py convert photo.jpg photo.ssrf --size 800x480 --type binary --lz4
+    slideshow_frame.py info photo.ssrf
+    slideshow_frame.py blurhash photo.jpg
+
+`blurhash` prints the preview code for a queue item ("source|code"), which the
+slideshow renders while the image itself loads.
+
+Requires Pillow. LZ4 uses the `lz4` package when installed and a slower
+built-in compressor otherwise; both produce standard LZ4 blocks.
+"""
+import argparse
+import math
+import struct
+import sys
+
+HEADER = struct.Struct("<IBBBBHHI")
+MAGIC = 0x46525353  # "SSRF"
+VERSION = 1
+
+# Values of esphome::image::ImageType
+TYPES = {"binary": 0, "grayscale": 1, "rgb565": 3}
+TYPE_NAMES = {value: name for name, value in TYPES.items()}
+COMPRESSION_NONE, COMPRESSION_LZ4 = 0, 1
+
+
+def frame_bytes(width, height, pixel_type):
+    """Size of the decoded frame, as slideshow_frame.h computes it."""
+    if pixel_type == TYPES["binary"]:
+        return (width + 7) // 8 * height
+    if pixel_type == TYPES["grayscale"]:
+        return width * height
+    return width * height * 2
+
+
+def fit_image(image, width, height, fit):
+    from PIL import Image, ImageOps
+
+    image = ImageOps.exif_transpose(image).convert("RGB")
+    if fit == "cover":
+        return ImageOps.fit(image, (width, height), Image.LANCZOS)
+    if fit == "contain":
+        canvas = Image.new("RGB", (width, height))
+        image = ImageOps.contain(image, (width, height), Image.LANCZOS)
+        canvas.paste(image, ((width - image.width) // 2, (height - image.height) // 2))
+        return canvas
+    return image.resize((width, height), Image.LANCZOS)
+
+
+def encode_pixels(image, pixel_type):
+    """Pixels in esphome::image::Image layout."""
+    if pixel_type == "rgb565":
+        out = bytearray()
+        for r, g, b in image.getdata():
+            value = (r >> 3) << 11 | (g >> 2) << 5 | b >> 3
+            out += bytes((value >> 8, value & 0xFF))
+        return bytes(out)
+    if pixel_type == "grayscale":
+        return image.convert("L").tobytes()
+    # binary: dithered, 1 bit per pixel, rows padded to a byte, MSB first
+    return image.convert("1").tobytes()
+
+
+def lz4_compress(data):
+    try:
+        import lz4.block
+
+        return lz4.block.compress(data, store_size=False)
+    except ImportError:
+        return lz4_compress_fallback(data)
+
+
+def lz4_compress_fallback(data):
+    """Greedy single-probe LZ4 block compressor."""
+    out = bytearray()
+    table = {}
+    n = len(data)
+    anchor = pos = 0
+    limit = n - 12  # The last 5 bytes are always literals; a match may not start after n - 12
+
+    def lengths(value):
+        while value >= 255:
+            out.append(255)
+            value -= 255
+        out.append(value)
+
+    while pos < limit:
+        key = data[pos:pos + 4]
+        candidate = table.get(key)
+        table[key] = pos
+        if candidate is None or pos - candidate > 0xFFFF:
+            pos += 1
+            continue
+
+        length = 4
+        while pos + length < n - 5 and data[candidate + length] == data[pos + length]:
+            length += 1
+
+        literals = pos - anchor
+        match = length - 4
+        out.append(min(literals, 15) << 4 | min(match, 15))
+        if literals >= 15:
+            lengths(literals - 15)
+        out += data[anchor:pos]
+        out += struct.pack("<H", pos - candidate)
+        if match >= 15:
+            lengths(match - 15)
+        pos += length
+        anchor = pos
+
+    literals = n - anchor
+    out.append(min(literals, 15) << 4)
+    if literals >= 15:
+        lengths(literals - 15)
+    out += data[anchor:]
+    return bytes(out)
+
+
+def convert(args):
+    from PIL import Image
+
+    try:
+        width, height = (int(v) for v in args.size.lower().split("x"))
+    except ValueError:
+        sys.exit(f"invalid --size {args.size!r}, expected WIDTHxHEIGHT")
+
+    with Image.open(args.input) as source:
+        image = fit_image(source, width, height, args.fit)
+    pixels = encode_pixels(image, args.type)
+
+    compression, payload = COMPRESSION_NONE, pixels
+    if args.lz4:
+        compressed = lz4_compress(pixels)
+        # Incompressible frames (noise, some photos at 1 bpp) are stored raw
+        if len(compressed) < len(pixels):
+            compression, payload = COMPRESSION_LZ4, compressed
+
+    with open(args.output, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, TYPES[args.type], compression, 0, width, height, len(payload)))
+        f.write(payload)
+
+    ratio = len(pixels) / len(payload)
+    print(f"{args.output}: {width}x{height} {args.type}, {len(payload)} bytes"
+          + (f" (LZ4, {ratio:.2f}x)" if compression == COMPRESSION_LZ4 else ""))
+
+
+BASE83 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz#$%*+,-.:;=?@[]^_{|}~"
+
+
+def base83(value, length):
+    return "".join(BASE83[value // 83 ** (length - 1 - i) % 83] for i in range(length))
+
+
+def srgb_to_linear(value):
+    v = value / 255
+    return v / 12.92 if v <= 0.04045 else ((v + 0.055) / 1.055) ** 2.4
+
+
+def linear_to_srgb(value):
+    v = min(max(value, 0.0), 1.0)
+    return round((v * 12.92 if v <= 0.0031308 else 1.055 * v ** (1 / 2.4) - 0.055) * 255)
+
+
+def blurhash_encode(image, components_x, components_y):
+    """BlurHash (https://blurha.sh) of an RGB image."""
+    # Only low frequencies are kept, so a thumbnail gives the same result
+    image = image.copy()
+    image.thumbnail((64, 64))
+    width, height = image.size
+    pixels = [[srgb_to_linear(c) for c in pixel] for pixel in image.getdata()]
+
+    factors = []
+    for j in range(components_y):
+        for i in range(components_x):
+            norm = 1 if i == 0 and j == 0 else 2
+            total = [0.0, 0.0, 0.0]
+            for y in range(height):
+                cos_y = math.cos(math.pi * j * y / height)
+                for x in range(width):
+                    basis = norm * math.cos(math.pi * i * x / width) * cos_y
+                    pixel = pixels[y * width + x]
+                    for c in range(3):
+                        total[c] += basis * pixel[c]
+            factors.append([t / (width * height) for t in total])
+
+    dc, ac = factors[0], factors[1:]
+    code = base83(components_x - 1 + (components_y - 1) * 9, 1)
+    max_value = 1.0
+    if ac:
+        quantized_max = max(0, min(82, math.floor(max(abs(c) for f in ac for c in f) * 166 - 0.5)))
+        max_value = (quantized_max + 1) / 166
+        code += base83(quantized_max, 1)
+    else:
+        code += base83(0, 1)
+    code += base83(linear_to_srgb(dc[0]) << 16 | linear_to_srgb(dc[1]) << 8 | linear_to_srgb(dc[2]), 4)
+
+    def quantize(v):
+        return max(0, min(18, math.floor(math.copysign(abs(v / max_value) ** 0.5, v) * 9 + 9.5)))
+
+    for r, g, b in ac:
+        code += base83(quantize(r) * 19 * 19 + quantize(g) * 19 + quantize(b), 2)
+    return code
+
+
+def blurhash(args):
+    from PIL import Image, ImageOps
+
+    if not (1 <= args.x <= 9 and 1 <= args.y <= 9):
+        sys.exit("components must be between 1 and 9")
+    with Image.open(args.input) as source:
+        image = ImageOps.exif_transpose(source).convert("RGB")
+    print(blurhash_encode(image, args.x, args.y))
+
+
+def info(args):
+    with open(args.frame, "rb") as f:
+        raw = f.read(HEADER.size)
+    if len(raw) < HEADER.size:
+        sys.exit(f"{args.frame}: too short")
+    magic, version, pixel_type, compression, _, width, height, size = HEADER.unpack(raw)
+    if magic != MAGIC:
+        sys.exit(f"{args.frame}: not a raw frame")
+    frame = frame_bytes(width, height, pixel_type)
+    ratio = f" ({frame / size:.2f}x of {frame} frame bytes)" if compression == COMPRESSION_LZ4 and size else ""
+    print(f"version {version}, {width}x{height} {TYPE_NAMES.get(pixel_type, pixel_type)}, "
+          f"{'LZ4' if compression == COMPRESSION_LZ4 else 'uncompressed'}, payload {size} bytes{ratio}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("convert", help="convert an image to a raw frame")
+    p.add_argument("input")
+    p.add_argument("output")
+    p.add_argument("--size", required=True, help="panel resolution, e.g. 800x480")
+    p.add_argument("--type", choices=sorted(TYPES), default="rgb565", help="pixel type (default: rgb565)")
+    p.add_argument("--fit", choices=("cover", "contain", "stretch"), default="cover",
+                   help="how to fit the aspect ratio (default: cover)")
+    p.add_argument("--lz4", action="store_true", help="LZ4-compress the payload")
+    p.set_defaults(func=convert)
+
+    p = sub.add_parser("info", help="print a raw frame header")
+    p.add_argument("frame")
+    p.set_defaults(func=info)
+
+    p = sub.add_parser("blurhash", help="print the BlurHash preview code of an image")
+    p.add_argument("input")
+    p.add_argument("-x", type=int, default=4, help="horizontal components (default: 4)")
+    p.add_argument("-y", type=int, default=3, help="vertical components (default: 3)")
+    p.set_defaults(func=blurhash)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+"""Decode and replay slideshow event traces.
+
+Traces come from the slideshow component's `trace_size` ring buffer, either
+copied from the device log (`slideshow.dump_trace` without a path) or from the
+binary file written by `slideshow.dump_trace` with a `path`.
+
+    slideshow_trace.py decode device.log
+    slideshow_trace.py replay device.log --slots 3 --lookahead 1
+    slideshow_trace.py replay trace.bin --sweep
+
+`replay` first reports what the recorded device actually experienced. It then
+replays the same navigation (advance/previous/jump timing and the sources
+shown) against a prefetch/cache policy. Load latency and size per source come
+from the recorded loads. Loads of an item's variants are traced under the
+item's source, like navigation, so a variant upgrade is another load of it. It reports the time spent on the placeholder and the
+frame bytes loaded, so policy changes can be compared on real usage.
+"""
+import argparse
+import base64
+import re
+import statistics
+import struct
+import sys
+from collections import OrderedDict
+
+EVENT = struct.Struct("<IBBHI")
+FILE_HEADER = struct.Struct("<IIII")
+FILE_MAGIC = 0x52545353
+NO_SLOT = 0xFF
+
+ADVANCE, PREVIOUS, JUMP_TO, ENQUEUE, QUEUE_CLEAR, LOAD_START, READY, ERROR = range(1, 9)
+EVENT_NAMES = {
+    ADVANCE: "advance",
+    PREVIOUS: "previous",
+    JUMP_TO: "jump_to",
+    ENQUEUE: "enqueue",
+    QUEUE_CLEAR: "queue_clear",
+    LOAD_START: "load_start",
+    READY: "ready",
+    ERROR: "error",
+}
+NAVIGATION = (ADVANCE, PREVIOUS, JUMP_TO)
+FLAG_REVALIDATE = 1 << 0
+FLAG_CACHED = 1 << 1
+
+LOG_LINE = re.compile(r"TRACE (BEGIN \d+ \d+|END|[A-Za-z0-9+/=]+)\s*$")
+
+
+def parse_events(data):
+    return [EVENT.unpack_from(data, i) for i in range(0, len(data) - EVENT.size + 1, EVENT.size)]
+
+
+def load_trace(path):
+    """Return (events, dropped) from a binary trace file or a device log."""
+    with open(path, "rb") as f:
+        raw = f.read()
+
+    if len(raw) >= FILE_HEADER.size:
+        magic, _version, count, dropped = FILE_HEADER.unpack_from(raw)
+        if magic == FILE_MAGIC:
+            events = parse_events(raw[FILE_HEADER.size:FILE_HEADER.size + count * EVENT.size])
+            return events, dropped
+
+    # Log dump: use the last complete BEGIN..END block
+    block, dropped, result = None, 0, None
+    for line in raw.decode("utf-8", "replace").splitlines():
+        match = LOG_LINE.search(line)
+        if not match:
+            continue
+        token = match.group(1)
+        if token.startswith("BEGIN"):
+            block, dropped = bytearray(), int(token.split()[2])
+        elif token == "END":
+            if block is not None:
+                result = (parse_events(bytes(block)), dropped)
+            block = None
+        elif block is not None:
+            block += base64.b64decode(token)
+
+    if result is None:
+        sys.exit(f"{path}: no trace found")
+    return result
+
+
+def decode(args):
+    events, dropped = load_trace(args.trace)
+    if dropped:
+        print(f"# {dropped} older events were overwritten on the device")
+    start = events[0][0] if events else 0
+    for timestamp, kind, slot, flags, arg in events:
+        slot_str = "-" if slot == NO_SLOT else str(slot)
+        print(f"{timestamp - start:>10} {EVENT_NAMES.get(kind, kind):<12} slot={slot_str:<3} "
+              f"flags=0x{flags:04x} arg=0x{arg:08x}")
+
+
+class Recording:
+    """What the trace tells us about navigation and per-source loads."""
+
+    def __init__(self, events):
+        self.displays = []  # (time, source hash)
+        self.latency = {}  # source hash -> [ms]
+        self.size = {}  # source hash -> resident bytes once loaded
+        self.placeholder_ms = 0
+        self.loaded_bytes = 0
+        self.loads = 0
+
+        in_flight = {}  # slot -> (start, hash)
+        resident = {}  # slot -> (hash, ready time)
+        waiting = None  # (display time, hash) not yet ready
+
+        for timestamp, kind, slot, flags, arg in events:
+            if kind in NAVIGATION:
+                waiting = self._close_wait(waiting, timestamp)
+                self.displays.append((timestamp, arg))
+                if not any(h == arg for h, _ in resident.values()):
+                    waiting = (timestamp, arg)
+            elif kind == LOAD_START:
+                in_flight[slot] = (timestamp, arg)
+                resident.pop(slot, None)
+            elif kind in (READY, ERROR) and slot in in_flight:
+                start, source = in_flight.pop(slot)
+                if kind == ERROR:
+                    continue
+                resident[slot] = (source, timestamp)
+                if not flags & FLAG_CACHED:
+                    self.latency.setdefault(source, []).append(timestamp - start)
+                    self.size[source] = arg
+                    self.loaded_bytes += arg
+                    self.loads += 1
+                if waiting is not None and waiting[1] == source:
+                    self.placeholder_ms += timestamp - waiting[0]
+                    waiting = None
+
+        self.end = events[-1][0] if events else 0
+        self._close_wait(waiting, self.end)
+
+        all_latencies = [ms for values in self.latency.values() for ms in values]
+        self.default_latency = statistics.median(all_latencies) if all_latencies else 0
+        self.default_size = statistics.median(self.size.values()) if self.size else 0
+
+    def _close_wait(self, waiting, now):
+        if waiting is not None:
+            self.placeholder_ms += now - waiting[0]
+        return None
+
+    def latency_of(self, source):
+        values = self.latency.get(source)
+        return statistics.median(values) if values else self.default_latency
+
+    def size_of(self, source):
+        return self.size.get(source, self.default_size)
+
+
+def simulate(rec, slots, lookahead, keep_previous, hold, concurrency):
+    """Replay recorded navigation against a prefetch/cache policy."""
+    sequence = [source for _, source in rec.displays]
+    resident = OrderedDict()  # source -> ready time, in LRU order
+    channels = [0] * concurrency if concurrency else None
+    placeholder_ms = loaded_bytes = loads = 0
+
+    for i, (now, source) in enumerate(rec.displays):
+        desired = [source] + sequence[i + 1:i + 1 + lookahead]
+        if keep_previous and i > 0:
+            desired.append(sequence[i - 1])
+        desired = list(OrderedDict.fromkeys(desired))
+
+        if not hold:
+            for held in [s for s in resident if s not in desired]:
+                del resident[held]
+
+        for wanted in desired:
+            if wanted in resident:
+                resident.move_to_end(wanted)
+                continue
+            if len(resident) >= slots:
+                victims = [s for s in resident if s not in desired]
+                if not victims:
+                    continue
+                del resident[victims[0]]
+            start = now
+            if channels is not None:
+                channel = min(range(concurrency), key=lambda c: channels[c])
+                start = max(now, channels[channel])
+                channels[channel] = start + rec.latency_of(wanted)
+            resident[wanted] = start + rec.latency_of(wanted)
+            loaded_bytes += rec.size_of(wanted)
+            loads += 1
+
+        shown_until = rec.displays[i + 1][0] if i + 1 < len(rec.displays) else rec.end
+        placeholder_ms += max(0, min(resident.get(source, shown_until), shown_until) - now)
+
+    return placeholder_ms, loaded_bytes, loads
+
+
+def replay(args):
+    events, dropped = load_trace(args.trace)
+    rec = Recording(events)
+    if not rec.displays:
+        sys.exit("trace contains no advance/previous/jump_to events")
+
+    print(f"{len(events)} events, {len(rec.displays)} displays over {(rec.end - events[0][0]) / 1000:.1f}s"
+          + (f" ({dropped} events dropped on device)" if dropped else ""))
+    print(f"median load latency {rec.default_latency:.0f}ms, median frame {rec.default_size / 1024:.0f}KiB")
+    print()
+    print(f"{'policy':<40} {'placeholder':>12} {'loads':>6} {'frame MiB':>10}")
+    print(f"{'recorded':<40} {rec.placeholder_ms / 1000:>11.1f}s {rec.loads:>6} "
+          f"{rec.loaded_bytes / 1048576:>10.1f}")
+
+    if args.sweep:
+        policies = [(slots, lookahead) for slots in (2, 3, 4, 5, 6) for lookahead in (1, 2, 3) if lookahead + 2 <= slots]
+    else:
+        policies = [(args.slots, args.lookahead)]
+
+    for slots, lookahead in policies:
+        placeholder_ms, loaded_bytes, loads = simulate(
+            rec, slots, lookahead, not args.no_previous, args.hold, args.concurrency)
+        name = f"slots={slots} lookahead={lookahead}" + (" hold" if args.hold else "")
+        print(f"{name:<40} {placeholder_ms / 1000:>11.1f}s {loads:>6} {loaded_bytes / 1048576:>10.1f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("decode", help="print the events of a trace")
+    p.add_argument("trace", help="device log or binary trace file")
+    p.set_defaults(func=decode)
+
+    p = sub.add_parser("replay", help="replay a trace against prefetch/cache policies")
+    p.add_argument("trace", help="device log or binary trace file")
+    p.add_argument("--slots", type=int, default=3, help="image slots (default: 3)")
+    p.add_argument("--lookahead", type=int, default=1, help="items prefetched ahead (default: 1)")
+    p.add_argument("--no-previous", action="store_true", help="do not keep the previous image loaded")
+    p.add_argument("--hold", action="store_true", help="keep frames outside the window (revalidate: true)")
+    p.add_argument("--concurrency", type=int, default=0, help="max concurrent loads, 0 = unlimited")
+    p.add_argument("--sweep", action="store_true", help="compare a grid of slot/lookahead policies")
+    p.set_defaults(func=replay)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()